@@ -0,0 +1,290 @@
+#pragma once
+
+#include "Bindings.h"
+
+#include <cstdlib>
+#include <stdexcept>
+
+#include "deus.hpp"
+
+/**
+ * @brief A flat, open-addressing hash map from chunk
+ * positions to pointers, made specifically for indexing
+ * chunks of the world.
+ *
+ * Positions are packed into a single 64-bit key and
+ * stored right next to the pointer in one contiguous
+ * array of slots - there are no nodes, no buckets and
+ * no heap allocation per entry, only a reallocation
+ * of the whole table when it grows.
+ *
+ * Collisions are resolved with linear probing, erasing
+ * uses backward shifting, so there are no tombstones
+ * and lookups never degrade after many insertions and erasures.
+ *
+ * A slot is empty if its value is nullptr, which means
+ * nullptr values cannot be stored (and there's no point in doing so).
+ * The map does NOT own the stored pointers.
+ *
+ * @tparam T type of the pointed-to values
+ *
+ * @throws std::bad_alloc if it fails to (re)allocate memory
+ */
+template<typename T> class ChunkMap {
+    private:
+        typedef struct {
+            u64 key;
+            T* value;
+        } Slot;
+
+        Slot* slots = nullptr;
+        //Always a power of 2
+        u64 numberOfSlots = 0;
+        u64 numberOfEntries = 0;
+        //How many times the table had to grow
+        u64 numberOfGrowths = 0;
+        //log2(numberOfSlots), used to take the top bits of the hash
+        u32 shift = 64;
+
+        /**
+         * @brief Spreads the lower 32 bits of `v` so that
+         * there is a 0 bit between every 2 bits of the input.
+         */
+        static constexpr u64 __spreadBits(u64 v) {
+            v &= 0xFFFFFFFF;
+            v = (v | (v << 16)) & 0x0000FFFF0000FFFF;
+            v = (v | (v << 8))  & 0x00FF00FF00FF00FF;
+            v = (v | (v << 4))  & 0x0F0F0F0F0F0F0F0F;
+            v = (v | (v << 2))  & 0x3333333333333333;
+            v = (v | (v << 1))  & 0x5555555555555555;
+            return v;
+        }
+
+        /**
+         * @brief Hashes the packed key.
+         *
+         * Coordinates are first biased so that chunks around
+         * the origin don't have all of their upper bits flipped
+         * just by being negative, then interleaved into
+         * a Morton (Z-order) code, so that chunks close to each other
+         * in the world have close codes, and finally mixed with
+         * Fibonacci hashing. The top bits are then used as the index.
+         */
+        static constexpr u64 __hash(const u64 key) {
+            u64 x = (key & 0xFFFFFFFF) ^ 0x80000000;
+            u64 y = (key >> 32) ^ 0x80000000;
+            u64 morton = __spreadBits(x) | (__spreadBits(y) << 1);
+            return morton * 0x9E3779B97F4A7C15;
+        }
+
+        ForceInline u64 __indexOf(const u64 key) const {
+            return __hash(key) >> this->shift;
+        }
+
+        ForceInline u64 __next(const u64 index) const {
+            return (index + 1) & (this->numberOfSlots - 1);
+        }
+
+        void __allocate(const u64 capacity) {
+            this->slots = (Slot*)calloc(capacity, sizeof(Slot));
+            if(this->slots == nullptr) Unlikely throw std::bad_alloc();
+            this->numberOfSlots = capacity;
+            this->shift = 64;
+            for(u64 c = capacity; c > 1; c >>= 1) this->shift--;
+        }
+
+        void __rehash(const u64 newCapacity) {
+            Slot* oldSlots = this->slots;
+            u64 oldNumberOfSlots = this->numberOfSlots;
+
+            this->__allocate(newCapacity);
+            for(u64 i = 0; i < oldNumberOfSlots; i++) {
+                if(oldSlots[i].value == nullptr) continue;
+                u64 index = this->__indexOf(oldSlots[i].key);
+                while(this->slots[index].value != nullptr) index = this->__next(index);
+                this->slots[index] = oldSlots[i];
+            }
+            free(oldSlots);
+        }
+
+        ForceInline void __growIfNeeded() {
+            //maximum load factor of 3/4
+            if((this->numberOfEntries + 1) * 4 > this->numberOfSlots * 3) {
+                this->__rehash(this->numberOfSlots * 2);
+                this->numberOfGrowths++;
+            }
+        }
+    public:
+        /**
+         * @brief Packs a chunk position into a single 64-bit key.
+         */
+        static constexpr u64 pack(const Structs::ChunkPos pos) {
+            return (u64)(u32)pos.x | ((u64)(u32)pos.y << 32);
+        }
+
+        /**
+         * @brief Unpacks a 64-bit key into a chunk position.
+         */
+        static constexpr Structs::ChunkPos unpack(const u64 key) {
+            return {(i32)(u32)(key & 0xFFFFFFFF), (i32)(u32)(key >> 32)};
+        }
+
+        /**
+         * @brief Constructs a ChunkMap.
+         *
+         * @param initialCapacity number of slots initially allocated,
+         * rounded up to a power of 2
+         *
+         * @throws std::bad_alloc on allocation failure
+         */
+        explicit ChunkMap(const u64 initialCapacity) {
+            this->__allocate(initialCapacity < 16 ? 16 : roundUpToPowerOf2(initialCapacity));
+        }
+
+        ~ChunkMap() {
+            free(this->slots);
+        }
+
+        ChunkMap(const ChunkMap&) = delete;
+        ChunkMap& operator=(const ChunkMap&) = delete;
+
+        /**
+         * @brief Finds the value bound to the given position.
+         * Never modifies the map.
+         *
+         * @param pos chunk position
+         * @return the stored pointer or nullptr if there is none
+         */
+        T* find(const Structs::ChunkPos pos) const noexcept {
+            const u64 key = pack(pos);
+            u64 index = this->__indexOf(key);
+            while(this->slots[index].value != nullptr) {
+                if(this->slots[index].key == key) return this->slots[index].value;
+                index = this->__next(index);
+            }
+            return nullptr;
+        }
+
+        /**
+         * @brief Whether there is a value bound to the given position.
+         */
+        bool contains(const Structs::ChunkPos pos) const noexcept { return this->find(pos) != nullptr; }
+
+        /**
+         * @brief Binds `value` to the given position.
+         * If there already is a value bound, it is NOT replaced.
+         *
+         * @param pos chunk position
+         * @param value pointer to store, cannot be nullptr
+         * @return `Enums::Status::SUCCESS` on success,
+         *
+         * `Enums::Status::ALREADY_EXISTS` if there already is a value
+         * bound to `pos`,
+         *
+         * `Enums::Status::NULL_PASSED` if `value` is nullptr.
+         *
+         * @throws std::bad_alloc if the map fails to grow
+         */
+        Enums::Status insert(const Structs::ChunkPos pos, T* value) {
+            if(value == nullptr) return Enums::Status::NULL_PASSED;
+            this->__growIfNeeded();
+
+            const u64 key = pack(pos);
+            u64 index = this->__indexOf(key);
+            while(this->slots[index].value != nullptr) {
+                if(this->slots[index].key == key) return Enums::Status::ALREADY_EXISTS;
+                index = this->__next(index);
+            }
+            this->slots[index].key = key;
+            this->slots[index].value = value;
+            this->numberOfEntries++;
+
+            return Enums::Status::SUCCESS;
+        }
+
+        /**
+         * @brief Unbinds the value from the given position.
+         *
+         * @param pos chunk position
+         * @return the pointer that was stored or nullptr if there was none,
+         * the caller is responsible for freeing it
+         */
+        T* erase(const Structs::ChunkPos pos) noexcept {
+            const u64 key = pack(pos);
+            u64 index = this->__indexOf(key);
+            while(this->slots[index].value != nullptr) {
+                if(this->slots[index].key == key) break;
+                index = this->__next(index);
+            }
+            T* value = this->slots[index].value;
+            if(value == nullptr) return nullptr;
+
+            //Backward shift deletion - move every following entry
+            //of the cluster that would be reachable from the hole
+            //one slot closer to its ideal position.
+            u64 hole = index, next = this->__next(index);
+            while(this->slots[next].value != nullptr) {
+                u64 ideal = this->__indexOf(this->slots[next].key);
+                //whether `ideal` lies cyclically in (hole, next]
+                bool reachable = hole <= next
+                    ? (ideal > hole && ideal <= next)
+                    : (ideal > hole || ideal <= next);
+                if(!reachable) {
+                    this->slots[hole] = this->slots[next];
+                    hole = next;
+                }
+                next = this->__next(next);
+            }
+            this->slots[hole].value = nullptr;
+            this->numberOfEntries--;
+
+            return value;
+        }
+
+        /**
+         * @brief Makes sure the map can hold at least `n` entries
+         * without growing.
+         *
+         * @throws std::bad_alloc on reallocation failure
+         */
+        void reserve(const u64 n) {
+            u64 needed = roundUpToPowerOf2(n + n / 3 + 1);
+            if(needed > this->numberOfSlots) this->__rehash(needed);
+        }
+
+        /**
+         * @brief Removes every entry without freeing the table.
+         * Stored pointers are not freed.
+         */
+        void clear() noexcept {
+            memset((void*)this->slots, 0, this->numberOfSlots * sizeof(Slot));
+            this->numberOfEntries = 0;
+        }
+
+        /**
+         * @brief Get number of entries in the map.
+         */
+        u64 size() const noexcept { return this->numberOfEntries; }
+        /**
+         * @brief Get number of slots in the map.
+         *
+         * The capacity will always be a power of 2.
+         */
+        u64 capacity() const noexcept { return this->numberOfSlots; }
+        /**
+         * @brief Get how many times the map had to grow since its creation.
+         * Lookups never make it grow, only insertions do.
+         */
+        u64 growths() const noexcept { return this->numberOfGrowths; }
+
+        /**
+         * @brief Calls `func(ChunkPos, T*)` for every entry in the map,
+         * in no particular order. The map must not be modified meanwhile.
+         */
+        template<typename F> void forEach(F func) const {
+            for(u64 i = 0; i < this->numberOfSlots; i++) {
+                if(this->slots[i].value == nullptr) continue;
+                func(unpack(this->slots[i].key), this->slots[i].value);
+            }
+        }
+};
\ No newline at end of file
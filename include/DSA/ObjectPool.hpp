@@ -0,0 +1,182 @@
+#pragma once
+
+#include "Bindings.h"
+
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "deus.hpp"
+
+/**
+ * @brief Allocation statistics of an ObjectPool.
+ */
+typedef struct {
+    //Number of pages allocated
+    u64 pages;
+    //Number of objects that fit in all allocated pages
+    u64 capacity;
+    //Number of objects currently alive
+    u64 used;
+    //Total number of objects ever created
+    u64 allocations;
+    //Number of objects created in place of previously destroyed ones
+    u64 recycled;
+    //Number of bytes taken by all pages
+    u64 bytes;
+} ObjectPoolStats;
+
+/**
+ * @brief A slab allocator for objects of a single type.
+ *
+ * Objects are carved from large pages, each holding `objectsPerPage`
+ * of them, instead of being allocated one by one on the heap.
+ * Destroyed objects are put on a free list and their memory
+ * is reused by the next creation, pages are only freed
+ * all at once, when the pool is released or destroyed.
+ *
+ * This keeps objects of the same kind close to each other
+ * and avoids fragmenting the heap when many of them are
+ * created and destroyed over time.
+ *
+ * The pool does NOT call destructors of objects that are still
+ * alive when it's released - they have to be destroyed
+ * with `destroy()` first if their destructors matter.
+ *
+ * @tparam T type of the objects
+ * @tparam objectsPerPage number of objects in a single page
+ */
+template<typename T, u32 objectsPerPage = 256> class ObjectPool {
+    static_assert(objectsPerPage > 0, "A page has to hold at least 1 object");
+    private:
+        typedef union Block {
+            union Block* next;
+            alignas(T) u8 storage[sizeof(T)];
+        } Block;
+
+        typedef struct Page {
+            struct Page* next;
+            Block blocks[objectsPerPage];
+        } Page;
+
+        Page* pages = nullptr;
+        //Recycled blocks
+        Block* freeList = nullptr;
+        //Number of blocks of the newest page that were never handed out
+        u32 untouched = 0;
+
+        u64 numberOfPages = 0;
+        u64 numberOfUsed = 0;
+        u64 numberOfAllocations = 0;
+        u64 numberOfRecycled = 0;
+
+        Block* __allocateBlock() noexcept {
+            if(this->freeList != nullptr) Likely {
+                Block* block = this->freeList;
+                this->freeList = block->next;
+                this->numberOfRecycled++;
+                return block;
+            }
+            if(this->untouched == 0) {
+                Page* page = (Page*)malloc(sizeof(Page));
+                if(page == nullptr) Unlikely return nullptr;
+                page->next = this->pages;
+                this->pages = page;
+                this->untouched = objectsPerPage;
+                this->numberOfPages++;
+            }
+            return &this->pages->blocks[objectsPerPage - this->untouched--];
+        }
+    public:
+        ObjectPool() = default;
+
+        ~ObjectPool() { this->release(); }
+
+        ObjectPool(const ObjectPool&) = delete;
+        ObjectPool& operator=(const ObjectPool&) = delete;
+
+        /**
+         * @brief Constructs a new object in the pool.
+         *
+         * @tparam Args constructor arguments
+         * @param args constructor arguments
+         * @return pointer to the object or nullptr if a new page
+         * could not be allocated
+         */
+        template<class...Args> T* create(Args&&...args) noexcept(std::is_nothrow_constructible_v<T, Args...>) {
+            Block* block = this->__allocateBlock();
+            if(block == nullptr) Unlikely return nullptr;
+
+            T* object;
+            if constexpr(std::is_nothrow_constructible_v<T, Args...>) {
+                object = new (block->storage) T(std::forward<Args>(args)...);
+            }
+            else {
+                try {
+                    object = new (block->storage) T(std::forward<Args>(args)...);
+                }
+                catch(...) {
+                    block->next = this->freeList;
+                    this->freeList = block;
+                    throw;
+                }
+            }
+            this->numberOfUsed++;
+            this->numberOfAllocations++;
+            return object;
+        }
+
+        /**
+         * @brief Destroys an object created by this pool
+         * and puts its memory on the free list.
+         *
+         * @param object object to destroy, nullptr is ignored
+         */
+        void destroy(T* object) noexcept {
+            if(object == nullptr) return;
+            object->~T();
+            Block* block = reinterpret_cast<Block*>(object);
+            block->next = this->freeList;
+            this->freeList = block;
+            this->numberOfUsed--;
+        }
+
+        /**
+         * @brief Frees every page at once, without calling
+         * destructors of the objects still alive.
+         * Every pointer obtained from the pool becomes dangling.
+         */
+        void release() noexcept {
+            Page* current = this->pages;
+            while(current != nullptr) {
+                Page* next = current->next;
+                free(current);
+                current = next;
+            }
+            this->pages = nullptr;
+            this->freeList = nullptr;
+            this->untouched = 0;
+            this->numberOfPages = 0;
+            this->numberOfUsed = 0;
+        }
+
+        /**
+         * @brief Get number of objects currently alive.
+         */
+        u64 size() const noexcept { return this->numberOfUsed; }
+
+        /**
+         * @brief Get allocation statistics of the pool.
+         */
+        ObjectPoolStats getStats() const noexcept {
+            return {
+                this->numberOfPages,
+                this->numberOfPages * objectsPerPage,
+                this->numberOfUsed,
+                this->numberOfAllocations,
+                this->numberOfRecycled,
+                this->numberOfPages * sizeof(Page)
+            };
+        }
+};
\ No newline at end of file
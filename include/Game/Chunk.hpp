@@ -0,0 +1,216 @@
+#pragma once
+
+#include "Bindings.h"
+
+#include <cstdlib>
+
+#include "deus.hpp"
+
+/**
+ * @brief A 16x16 piece of the world, storing IDs of its blocks
+ * in a palette-compressed format.
+ *
+ * Instead of storing the 32-bit ID of every block, the chunk stores
+ * a palette - a small list of distinct block IDs it contains - and
+ * for every block an index into that palette, packed using
+ * as few bits as possible (0, 1, 2, 4 or 8 bits per block).
+ *
+ * A chunk made of a single block (bits per block = 0) doesn't
+ * allocate anything and stores that block's ID directly.
+ * Since there are only 256 blocks in a chunk, there are at most
+ * 256 distinct IDs, so 8 bits per block is always enough.
+ *
+ * Writes automatically re-pack the chunk: when a new ID doesn't
+ * fit in the palette, unused palette entries are dropped first
+ * and only if that's not enough, the number of bits per block grows.
+ *
+ * Memory used by a chunk (this object + palette + indices):
+ *
+ * 0 bits - 24 bytes,
+ *
+ * 1 bit - 64 bytes,
+ *
+ * 2 bits - 104 bytes,
+ *
+ * 4 bits - 216 bytes,
+ *
+ * 8 bits - 1304 bytes,
+ *
+ * as opposed to 1024 bytes for a raw `u32[16][16]`.
+ */
+class Chunk {
+    public:
+        //Number of blocks along each side of the chunk
+        static constexpr u32 size = 16;
+        //Number of blocks in the chunk
+        static constexpr u32 numberOfBlocks = size * size;
+    private:
+        //Source of versions, shared by all chunks
+        static u32 nextVersion;
+
+        /**
+         * @brief Palette followed by packed indices.
+         *
+         * The palette has space for `1 << bitsPerBlock` IDs,
+         * indices are packed into 32-bit words, so that
+         * no index crosses a word boundary.
+         *
+         * nullptr if the chunk is uniform.
+         */
+        u32* storage = nullptr;
+        //ID of every block if the chunk is uniform
+        u32 uniformID = 0;
+        //Changes every time any block of the chunk changes
+        u32 version;
+        //Number of used palette entries
+        u16 paletteSize = 0;
+        u8 bitsPerBlock = 0;
+        //log2(bitsPerBlock), only valid if bitsPerBlock != 0
+        u8 bitsPerBlockShift = 0;
+
+        ForceInline void __touch() { this->version = nextVersion++; }
+
+        ForceInline u32* __palette() const { return this->storage; }
+        ForceInline u32* __indices() const { return this->storage + ((u32)1 << this->bitsPerBlock); }
+
+        ForceInline u32 __getIndex(const u32 i) const {
+            const u32 bit = i << this->bitsPerBlockShift;
+            return (this->__indices()[bit >> 5] >> (bit & 31)) & (((u32)1 << this->bitsPerBlock) - 1);
+        }
+
+        ForceInline void __setIndex(const u32 i, const u32 index) {
+            const u32 bit = i << this->bitsPerBlockShift;
+            const u32 mask = (((u32)1 << this->bitsPerBlock) - 1) << (bit & 31);
+            u32& word = this->__indices()[bit >> 5];
+            word = (word & ~mask) | (index << (bit & 31));
+        }
+
+        /**
+         * @brief Rebuilds the chunk from raw block IDs,
+         * using the smallest possible palette and number of bits.
+         *
+         * @param ids 256 block IDs, row by row
+         * @return `Enums::Status::SUCCESS` or `Enums::Status::ALLOC_FAILURE`,
+         * in which case the chunk is left untouched
+         */
+        Enums::Status __pack(const u32* ids) noexcept;
+    public:
+        /**
+         * @brief Constructs a chunk made entirely of one block.
+         *
+         * @param blockID ID of the block
+         */
+        explicit Chunk(const u32 blockID) : uniformID(blockID), version(nextVersion++) {}
+
+        ~Chunk() { free(this->storage); }
+
+        Chunk(const Chunk&) = delete;
+        Chunk& operator=(const Chunk&) = delete;
+
+        /**
+         * @brief Get ID of the block at given position within the chunk.
+         *
+         * @param x horizontal position, from 0 to 15
+         * @param y vertical position, from 0 to 15
+         */
+        ForceInline u32 getBlockID(const u32 x, const u32 y) const {
+            if(this->bitsPerBlock == 0) return this->uniformID;
+            return this->__palette()[this->__getIndex(y * size + x)];
+        }
+
+        /**
+         * @brief Copies IDs of a horizontal run of blocks into `out`,
+         * decoding the palette only once per call.
+         *
+         * @param x horizontal position of the first block, from 0 to 15
+         * @param y vertical position of the row, from 0 to 15
+         * @param count number of blocks to copy, `x + count` must not exceed 16
+         * @param out array of at least `count` IDs
+         */
+        ForceInline void getBlockIDs(const u32 x, const u32 y, const u32 count, u32* out) const {
+            if(this->bitsPerBlock == 0) {
+                for(u32 i = 0; i < count; i++) out[i] = this->uniformID;
+                return;
+            }
+            const u32* palette = this->__palette();
+            const u32 first = y * size + x;
+            for(u32 i = 0; i < count; i++) out[i] = palette[this->__getIndex(first + i)];
+        }
+
+        /**
+         * @brief Sets ID of the block at given position within the chunk,
+         * re-packing the chunk if needed.
+         *
+         * @param x horizontal position, from 0 to 15
+         * @param y vertical position, from 0 to 15
+         * @param blockID ID of the block
+         * @return `Enums::Status::SUCCESS` on success,
+         *
+         * `Enums::Status::ALLOC_FAILURE` if re-packing failed,
+         * in which case the block is not changed.
+         */
+        Enums::Status setBlockID(const u32 x, const u32 y, const u32 blockID) noexcept;
+
+        /**
+         * @brief Fills the entire chunk with one block,
+         * making it uniform and freeing its palette.
+         *
+         * @param blockID ID of the block
+         */
+        void fill(const u32 blockID) noexcept;
+
+        /**
+         * @brief Re-packs the chunk using the smallest possible
+         * palette and number of bits per block, dropping
+         * palette entries no longer used by any block.
+         *
+         * @return `Enums::Status::SUCCESS` or `Enums::Status::ALLOC_FAILURE`,
+         * in which case the chunk is left untouched
+         */
+        Enums::Status repack() noexcept;
+
+        /**
+         * @brief Whether the chunk is made of a single block.
+         * Only guaranteed to be accurate after `repack()`.
+         */
+        bool isUniform() const { return this->bitsPerBlock == 0; }
+
+        /**
+         * @brief Get version of the chunk's contents.
+         *
+         * Versions are unique across all chunks and a new one
+         * is assigned whenever any block changes, so anything
+         * derived from the chunk (e.g. a pre-rendered texture)
+         * is up to date as long as the version it was made from
+         * is still equal to this one.
+         */
+        u32 getVersion() const { return this->version; }
+
+        /**
+         * @brief Get the version the next change to any chunk will get,
+         * so that changes anywhere can be detected by comparing it.
+         */
+        static u32 getNextVersion() { return nextVersion; }
+
+        /**
+         * @brief Get number of bits used for each block.
+         */
+        u32 getBitsPerBlock() const { return this->bitsPerBlock; }
+
+        /**
+         * @brief Get number of entries in the chunk's palette.
+         */
+        u32 getPaletteSize() const { return this->bitsPerBlock == 0 ? 1 : this->paletteSize; }
+
+        /**
+         * @brief Get number of bytes used by the chunk,
+         * including the palette and indices.
+         */
+        size_t getMemoryUsage() const {
+            if(this->bitsPerBlock == 0) return sizeof(Chunk);
+            return sizeof(Chunk) + sizeof(u32) * (
+                ((size_t)1 << this->bitsPerBlock) +
+                ((size_t)numberOfBlocks * this->bitsPerBlock) / 32
+            );
+        }
+};
\ No newline at end of file
@@ -2,12 +2,22 @@
 
 #include "Bindings.h"
 
+#include "Game/Main/FrameProfiler.hpp"
+#include "Game/Render/ChunkTextureCache.hpp"
+#include "Game/Render/GlyphAtlas.hpp"
+#include "Game/Render/RenderTargetPool.hpp"
+#include "Game/Render/RenderThread.hpp"
+#include "Game/Render/ShapeRenderer.hpp"
+#include "Game/Render/SpriteBatch.hpp"
+#include "Game/Render/TextureAtlas.hpp"
+#include "Game/Render/TextureMipChain.hpp"
 #include "Game/Render/UIElement.hpp"
+#include "Game/Render/UITextElement.hpp"
+#include "Game/Render/WorldOverview.hpp"
 #include "Game/Physics/PhysicalObject.hpp"
 #include "DSA/ListArray.hpp"
 #include "program.hpp"
 
-// void startRender(RenderThreadParameters* params);
 class Game;
 
 class GameRenderer {
@@ -17,31 +27,246 @@ class GameRenderer {
     private:
         ListArray<PhysicalObject*> physicalObjectsToRender;
         ListArray<UIElement> uiElements;
+        //Drawn after every other UI element
+        ListArray<UITextElement> uiTextElements;
+        ChunkTextureCache chunkTextureCache;
+        //Textures of all blocks, indexed by block IDs
+        TextureAtlas blockAtlas;
+        //Downsampled block textures and their average colors
+        TextureMipChain blockMips;
+        //The world at one pixel per block, drawn when zoomed out the furthest
+        WorldOverview overview;
+        TileBatch blockBatch;
+        SpriteBatch uiBatch;
+        //Offscreen textures reused across frames
+        RenderTargetPool renderTargets;
+        ShapeRenderer shapes;
+        //Glyph atlases of every font text is drawn with
+        TextRenderer text;
+        //Executes recorded frames, while the next one is simulated
+        RenderThread renderThread;
+        //Times stages of every drawn frame
+        FrameProfiler profiler;
+        //The profiler's statistics, as shown by the overlay
+        char profilerOverlayText[1024] = {};
+        //Tick at which the overlay's text was last updated
+        u64 profilerOverlayUpdatedAt = 0;
+        bool profilerOverlayVisible = false;
+        bool profilerOverlayOutdated = true;
+        //Whether the animated render testing section is drawn
+        bool renderTestVisible = false;
         
+
+        //Frame rate limit, 0 for none
         u32 fps = 144;
         double scalingFactor = 1.0;
 
-        //Registers the timestamp when rendering
+        //Registers the timestamp when recording
         //the latest frame has ended
         u64 lastFrameAt = 0;
         //Counts the number of frames since rendering started
         u64 numberOfFramesRendered = 0;
+        //Counters of the latest drawn frame
+        RenderStats frameStats = {};
+        //Ticks every frame may spend creating textures loaded asynchronously
+        u64 textureUploadBudget = SDL_GetPerformanceFrequency() / 500;
         
         Structs::Point cameraPosition = {0, 0};
+        //Camera position as of the start of the latest simulation tick
+        Structs::Point previousCameraPosition = {0, 0};
+        //Version of renderable objects as of the start of the latest simulation tick
+        u64 uiVersionAtTickStart = 0;
+
+        //Everything a frame is drawn from
+        struct FrameState {
+            Structs::Point camera;
+            double scalingFactor;
+            Structs::Size windowSize;
+            Structs::Color backgroundColor;
+            u64 worldVersion;
+            u64 uiVersion;
+            //How far into the tick the frame is, 0 unless anything is interpolated
+            double alpha;
+            //Angle of the arc in the render testing section, 0 while it's hidden
+            double testAngle;
+
+            bool operator==(const FrameState& other) const;
+        };
+        FrameState lastFrameState = {};
+        //Whether the next frame has to be drawn, even if nothing changed
+        bool redrawRequested = true;
+        //Counts frames that were skipped for being identical to the previous one
+        u64 numberOfFramesSkipped = 0;
 
         void moveCamera(i32 offX, i32 offY);
+        void __drawProfilerOverlay(RenderCommandBuffer& commands, Structs::Size windowSize);
     public:
-        GameRenderer() : physicalObjectsToRender(4096), uiElements(4096) {}
+        //Ticks between updates of the profiler overlay's text
+        static constexpr u64 profilerOverlayInterval = 30;
+
+        GameRenderer() : physicalObjectsToRender(4096), uiElements(4096), uiTextElements(4096), chunkTextureCache(128 * 1024 * 1024), blockAtlas(2048), blockMips(1024), overview(256), renderTargets(120), shapes(60), text(512), profiler(SDL_GetPerformanceFrequency()) {}
 
         UIElement& registerUIElement(UIElement element) { return uiElements.append(std::move(element)); }
+        UITextElement& registerUITextElement(UITextElement element) { return uiTextElements.append(std::move(element)); }
 
         // void registerPhysicalObject(PhysicalObject* obj) { physicalObjectsToRender.append(std::move(obj)); }
 
         // void render();
-        void renderInPlace(Game& game);
+        /**
+         * @brief Records the current frame and submits it
+         * to the render thread (see `startRenderThread()`).
+         * The frame is skipped if nothing it's drawn from changed
+         * since the last one (see `requestRedraw()`).
+         * 
+         * @param game the game
+         * @param alpha how far into the next simulation tick the frame is,
+         * from 0 to 1; positions are interpolated between the last
+         * two ticks accordingly
+         */
+        void renderInPlace(Game& game, double alpha);
+
+        /**
+         * @brief Remembers positions as of the start of a simulation tick,
+         * so that frames can be drawn between this tick and the next one.
+         */
+        void beginTick();
+
+        /**
+         * @brief Starts executing submitted frames on a separate thread,
+         * if the rendering context supports it.
+         * 
+         * @param renderer rendering context
+         * @param threaded whether to use a separate thread at all,
+         * otherwise frames are executed right after being recorded.
+         * Off by default, see `RenderThread`
+         * @return `Enums::Status::SUCCESS` or `Enums::Status::FAILURE` if the thread
+         * could not be started, in which case frames are executed right after being recorded
+         */
+        Enums::Status startRenderThread(SDL_Renderer* renderer, bool threaded = false) {
+            return this->renderThread.start(renderer, threaded);
+        }
+
+        /**
+         * @brief Executes every submitted frame and stops the render thread.
+         */
+        void stopRenderThread() { this->renderThread.stop(); }
+
+        /**
+         * @brief Waits until every submitted frame has been executed.
+         */
+        void waitForSubmittedFrames() { this->renderThread.wait(); }
+
+        RenderThreadStats getRenderThreadStats() { return this->renderThread.getStats(); }
 
         u64 getTimeSinceLastFrame() const { return SDL_GetPerformanceCounter() - this->lastFrameAt; }
         u64 getNumberOfFramesRendered() const { return this->numberOfFramesRendered; }
+        u64 getNumberOfFramesSkipped() const { return this->numberOfFramesSkipped; }
+
+        /**
+         * @brief Get counters of the latest drawn frame (draw calls,
+         * state changes, culling), skipped frames leave them as they are.
+         */
+        const RenderStats& getRenderStats() const { return this->frameStats; }
+
+        /**
+         * @brief Sets how long every frame may spend creating textures
+         * loaded asynchronously, at least one is created per frame regardless.
+         *
+         * @param budget ticks of `SDL_GetPerformanceCounter()`
+         */
+        void setTextureUploadBudget(const u64 budget) { this->textureUploadBudget = budget; }
+
+        /**
+         * @brief Makes the next frame be drawn, even if nothing tracked changed.
+         * Needed after the window's contents are lost and after changes
+         * that aren't tracked, like replacing a texture's contents.
+         */
+        void requestRedraw() { this->redrawRequested = true; }
+
+        /**
+         * @brief Get the profiler timing stages of every drawn frame.
+         */
+        FrameProfiler& getFrameProfiler() { return this->profiler; }
+
+        bool isProfilerOverlayVisible() const { return this->profilerOverlayVisible; }
+        /**
+         * @brief Shows or hides percentiles of frame stage times
+         * and render counters in the top right corner of the screen.
+         */
+        void setProfilerOverlayVisible(const bool visible) {
+            this->profilerOverlayVisible = visible;
+            this->profilerOverlayOutdated = true;
+            this->redrawRequested = true;
+        }
+
+        bool isRenderTestVisible() const { return this->renderTestVisible; }
+        /**
+         * @brief Shows or hides the animated render testing section.
+         * It changes every frame, so no frame is skipped while it's shown.
+         */
+        void setRenderTestVisible(const bool visible) {
+            this->renderTestVisible = visible;
+            this->redrawRequested = true;
+        }
 
         Structs::Point getCameraPosition() const { return this->cameraPosition; }
+
+        /**
+         * @brief Get the pool of offscreen textures,
+         * to be used instead of creating textures every frame.
+         */
+        RenderTargetPool& getRenderTargetPool() { return this->renderTargets; }
+        RenderTargetPoolStats getRenderTargetPoolStats() const { return this->renderTargets.getStats(); }
+
+        /**
+         * @brief Get the renderer of arcs, lines and polygons,
+         * drawing onto the current rendering target.
+         */
+        ShapeRenderer& getShapeRenderer() { return this->shapes; }
+        const ShapeRendererStats& getShapeRendererStats() const { return this->shapes.getStats(); }
+
+        /**
+         * @brief Get the renderer of text, laid out from glyph atlases.
+         * Text drawn with it is drawn when it's flushed.
+         */
+        TextRenderer& getTextRenderer() { return this->text; }
+        GlyphAtlasStats getTextRendererStats() const { return this->text.getStats(); }
+
+        const SpriteBatchStats& getUIBatchStats() const { return this->uiBatch.getStats(); }
+
+        ChunkTextureCacheStats getChunkTextureCacheStats() const { return this->chunkTextureCache.getStats(); }
+        WorldOverviewStats getWorldOverviewStats() const { return this->overview.getStats(); }
+
+        /**
+         * @brief Packs textures of every registered block into the block atlas,
+         * so that visible blocks can be drawn with one call per atlas page,
+         * and downsamples them for drawing while zoomed out.
+         * Has to be called after blocks are registered.
+         * Block textures are loaded synchronously and pinned, since
+         * the atlas is all that draws them afterwards.
+         * Waits for every submitted frame to be executed first.
+         * 
+         * @param renderer rendering context
+         * @return `Enums::Status::SUCCESS` or `Enums::Status::SDL_TEXTURE_CREATION_FAILURE`,
+         * in which case blocks are drawn one by one
+         */
+        Enums::Status buildBlockAtlas(SDL_Renderer* renderer);
+
+        /**
+         * @brief Destroys every texture owned by the renderer itself,
+         * after every submitted frame is executed.
+         * Has to be called before the rendering context is destroyed
+         * and whenever render targets are lost.
+         */
+        void releaseTextures() {
+            this->renderThread.wait();
+            std::lock_guard<std::recursive_mutex> lock(Program::getRenderingLock());
+            this->chunkTextureCache.clear();
+            this->blockAtlas.clear();
+            this->blockMips.clear();
+            this->overview.clear();
+            this->text.clear();
+            this->renderTargets.clear();
+            this->redrawRequested = true;
+        }
 };
\ No newline at end of file
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "Bindings.h"
+
+#include "deus.hpp"
+
+/**
+ * @brief Statistics of recent frame times, in milliseconds.
+ */
+typedef struct {
+    //Number of frames the statistics are computed from
+    u64 frames;
+    double mean;
+    //Standard deviation, i.e. jitter
+    double stddev;
+    //99th percentile
+    double p99;
+    double max;
+} FramePacerStats;
+
+enum class FramePacingMode : u8 {
+    //Sleep until shortly before the deadline, then spin until it
+    SLEEP,
+    //Presenting blocks until the display's refresh,
+    //so frames are only measured
+    VSYNC
+};
+
+/**
+ * @brief Paces the main loop to a target frame rate.
+ *
+ * Frames are scheduled on absolute deadlines (multiples of the frame length),
+ * so that time lost in one frame is made up in the next instead of
+ * accumulating. Waiting sleeps through most of the remaining time
+ * and spins on the performance counter for the rest, since sleeps
+ * only have millisecond granularity and may overshoot. The spinning margin
+ * follows how much sleeps have been overshooting lately.
+ *
+ * Durations of the last `historySize` frames are kept for jitter statistics.
+ */
+class FramePacer {
+    public:
+        static constexpr u32 historySize = 256;
+    private:
+        u64 clockFrequency;
+        //Ticks per frame, 0 if uncapped
+        u64 frameLength = 0;
+        u32 frameRate = 0;
+        FramePacingMode mode = FramePacingMode::SLEEP;
+
+        u64 nextFrameAt = 0;
+        u64 lastFrameAt = 0;
+        //Moving average of how much sleeps overshoot, in ticks
+        u64 sleepOvershoot = 0;
+
+        u64 frameTimes[historySize];
+        u32 numberOfFrameTimes = 0;
+        u32 frameTimeIndex = 0;
+
+        void __sleepUntil(u64 deadline);
+    public:
+        /**
+         * @brief Constructs a pacer.
+         *
+         * @param clockFrequency frequency of `SDL_GetPerformanceCounter()`
+         * @param frameRate target frame rate, 0 for uncapped
+         */
+        FramePacer(const u64 clockFrequency, const u32 frameRate) : clockFrequency(clockFrequency) {
+            this->setFrameRate(frameRate);
+        }
+
+        /**
+         * @brief Sets the target frame rate.
+         *
+         * @param frameRate frames per second, 0 for uncapped
+         */
+        void setFrameRate(u32 frameRate);
+        u32 getFrameRate() const { return this->frameRate; }
+
+        void setMode(const FramePacingMode mode) { this->mode = mode; }
+        FramePacingMode getMode() const { return this->mode; }
+
+        /**
+         * @brief Ends the current frame, waiting until the next one should start
+         * (unless uncapped or in VSync mode), and records its duration.
+         */
+        void endFrame();
+
+        /**
+         * @brief Forgets recorded frame times and the current schedule,
+         * e.g. after the loop was stalled on purpose.
+         */
+        void reset();
+
+        /**
+         * @brief Get statistics of the recorded frame times.
+         */
+        FramePacerStats getStats() const;
+};
\ No newline at end of file
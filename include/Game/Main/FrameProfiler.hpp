@@ -0,0 +1,163 @@
+#pragma once
+
+#include "Bindings.h"
+
+#include <atomic>
+
+#include <SDL_timer.h>
+
+#include "deus.hpp"
+#include "Tracing.hpp"
+
+enum class FrameStage : u8 {
+    //Processing events
+    INPUT,
+    //Simulation ticks
+    SIMULATION,
+    //Recording blocks and chunks
+    WORLD,
+    //Recording UI elements and shapes
+    UI,
+    //Creating and recording text textures
+    TEXT,
+    //Submitting the frame, which includes executing and presenting it
+    //unless it's done on the render thread
+    PRESENT
+};
+static constexpr u32 numberOfFrameStages = (u32)FrameStage::PRESENT + 1;
+
+/**
+ * @brief Percentiles of the time spent in a frame stage, in milliseconds.
+ */
+typedef struct {
+    double p50;
+    double p95;
+    double p99;
+} FrameStageStats;
+
+/**
+ * @brief Statistics of recently profiled frames.
+ */
+typedef struct {
+    //Number of frames the statistics are computed from
+    u64 frames;
+    //Indexed by `FrameStage`
+    FrameStageStats stages[numberOfFrameStages];
+} FrameProfilerStats;
+
+/**
+ * @brief Measures how long each stage of a frame takes.
+ *
+ * Stages are timed with `FrameProfiler::Scope` and the times of the last
+ * `historySize` frames are kept in a ring buffer. The buffer has a single
+ * writer (the main loop) and may be read from any thread without locking:
+ * readers copy it and drop frames overwritten while copying.
+ */
+class FrameProfiler {
+    public:
+        static constexpr u32 historySize = 256;
+
+        /**
+         * @brief Adds the time from its construction until `stop()`
+         * (or its destruction) to a stage of the current frame.
+         * When tracing, it's recorded as a zone too.
+         */
+        class Scope {
+            private:
+                FrameProfiler& profiler;
+                FrameStage stage;
+                u64 start;
+                bool stopped = false;
+            public:
+                Scope(FrameProfiler& profiler, const FrameStage stage) :
+                    profiler(profiler), stage(stage), start(SDL_GetPerformanceCounter()) {}
+
+                ~Scope() { this->stop(); }
+
+                Scope(const Scope&) = delete;
+                Scope& operator=(const Scope&) = delete;
+
+                void stop() {
+                    if(this->stopped) return;
+                    this->stopped = true;
+                    const u64 end = SDL_GetPerformanceCounter();
+                    this->profiler.add(this->stage, end - this->start);
+#ifdef TRACING
+                    Tracer::getThreadBuffer().record(getStageName(this->stage), this->start, end);
+#endif /* TRACING */
+                }
+        };
+    private:
+        typedef struct {
+            //Ticks spent in each stage
+            u64 stageTimes[numberOfFrameStages];
+        } FrameRecord;
+        //Fields are atomic only so that reading a slot while
+        //it's overwritten is defined; such reads are discarded
+        struct Slot {
+            std::atomic<u64> stageTimes[numberOfFrameStages];
+        };
+
+        //One more than the history, which is being written
+        //while the history is read
+        static constexpr u32 numberOfSlots = historySize + 1;
+
+        u64 clockFrequency;
+        Slot frames[numberOfSlots];
+        //Number of frames recorded so far, the latest one
+        //is at `(numberOfFrames - 1) % numberOfSlots`
+        std::atomic<u64> numberOfFrames = 0;
+        FrameRecord current = {};
+    public:
+        /**
+         * @brief Constructs a profiler.
+         *
+         * @param clockFrequency frequency of `SDL_GetPerformanceCounter()`
+         */
+        FrameProfiler(const u64 clockFrequency) : clockFrequency(clockFrequency) {}
+
+        FrameProfiler(const FrameProfiler&) = delete;
+        FrameProfiler& operator=(const FrameProfiler&) = delete;
+
+        static const char* getStageName(FrameStage stage);
+
+        /**
+         * @brief Starts a new frame, discarding the current one
+         * if it was never ended (e.g. because nothing was drawn).
+         */
+        void beginFrame() { this->current = {}; }
+
+        /**
+         * @brief Adds time to a stage of the current frame.
+         *
+         * @param stage the stage
+         * @param ticks time in ticks of `SDL_GetPerformanceCounter()`
+         */
+        void add(const FrameStage stage, const u64 ticks) { this->current.stageTimes[(u32)stage] += ticks; }
+
+        /**
+         * @brief Records the current frame into the ring buffer.
+         */
+        void endFrame();
+
+        u64 getNumberOfFrames() const { return this->numberOfFrames.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Get percentiles of every stage over the recorded frames.
+         */
+        FrameProfilerStats getStats() const;
+
+        /**
+         * @brief Writes the statistics as a table, one stage per line.
+         *
+         * @param buffer buffer to write into, always null-terminated
+         * @param size size of the buffer
+         * @return number of characters written, without the terminator
+         */
+        size_t format(char* buffer, size_t size) const;
+
+        /**
+         * @brief Writes the statistics to the log.
+         */
+        void dump() const;
+};
\ No newline at end of file
@@ -14,6 +14,7 @@
 #define GAME_HPP
 
 #include "Game/GameRenderer.hpp"
+#include "Game/Main/FramePacer.hpp"
 #include "Game/Main/MainRegistry.hpp"
 #include "Game/World.hpp"
 #include "program.hpp"
@@ -29,9 +30,28 @@ class Game : public Program {
         static InputHandler inputHandler;
 
         World world;
+        FramePacer framePacer;
+
+        //Simulation rate, independent of the frame rate
+        u32 ticksPerSecond = 60;
+        //Most ticks simulated before a frame, so that after a long stall
+        //the game skips ahead instead of trying to catch up
+        u32 maxTicksPerFrame = 8;
+        static u64 numberOfTicks;
+        //Rate of the main loop while paused or minimized, events
+        //wake it up earlier
+        u32 idleLoopRate = 10;
+        //Number of frames after which the game quits, 0 for no limit
+        u64 frameLimit = 0;
+        u64 numberOfFrames = 0;
+
+        /**
+         * @brief Advances the simulation by one tick.
+         */
+        void tick();
 
     public:
-        Game() : world(1) /* TODO: change this later */ {
+        Game() : world(1) /* TODO: change this later */, framePacer(SDL_GetPerformanceFrequency(), renderer.fps) {
             
         }
         ~Game();
@@ -43,8 +63,64 @@ class Game : public Program {
         void run();
 
         static u64 getTimeSinceLastFrame() { return renderer.getTimeSinceLastFrame(); }
+        /**
+         * @brief Get the number of simulation ticks since the game started.
+         * Anything moving over time should be driven by it, not by frames.
+         */
+        static u64 getNumberOfTicks() { return numberOfTicks; }
+
+        u32 getTicksPerSecond() const { return this->ticksPerSecond; }
+        void setTicksPerSecond(const u32 ticksPerSecond) { this->ticksPerSecond = ticksPerSecond > 0 ? ticksPerSecond : 1; }
+
+        u32 getIdleLoopRate() const { return this->idleLoopRate; }
+        /**
+         * @brief Sets how many times per second the main loop runs while
+         * the game is paused or minimized. In between, it sleeps until an event arrives.
+         * The sleep is measured in whole milliseconds, so the rate is kept between 1 and 1000.
+         */
+        void setIdleLoopRate(const u32 idleLoopRate) {
+            this->idleLoopRate = idleLoopRate > 0 ? (idleLoopRate < 1000 ? idleLoopRate : 1000) : 1;
+        }
+
+        u64 getFrameLimit() const { return this->frameLimit; }
+        /**
+         * @brief Makes the game quit after rendering the given number
+         * of frames, e.g. for benchmarks.
+         * 
+         * @param frameLimit number of frames, 0 for no limit
+         */
+        void setFrameLimit(const u64 frameLimit) { this->frameLimit = frameLimit; }
 
         World& getWorld() { return this->world; }
+
+        /**
+         * @brief Get the pacer limiting the frame rate,
+         * which also keeps statistics of frame times.
+         */
+        FramePacer& getFramePacer() { return this->framePacer; }
+
+        /**
+         * @brief Enables or disables VSync. With VSync, frames are paced
+         * by presenting them instead of by waiting.
+         * 
+         * @param enabled whether to enable VSync
+         * @return `Enums::Status::SUCCESS` or `Enums::Status::SDL_FAILURE`
+         * if the rendering context doesn't support changing it
+         */
+        Enums::Status setVSync(bool enabled);
+
+        /**
+         * @brief Saves the last rendered frame as a BMP file.
+         * Only available in headless mode.
+         * 
+         * @param path path of the file
+         * @return `Enums::Status::SUCCESS` on success,
+         * 
+         * `Enums::Status::FAILURE` if not headless,
+         * 
+         * `Enums::Status::SDL_FAILURE` if the file could not be written
+         */
+        Enums::Status saveFrame(const char* path);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,180 @@
+#pragma once
+
+#include "Bindings.h"
+
+#include <SDL_render.h>
+
+#include "deus.hpp"
+#include "DSA/ChunkMap.hpp"
+#include "Game/Chunk.hpp"
+#include "Game/Render/RenderCommandBuffer.hpp"
+#include "Game/Render/TextureAtlas.hpp"
+#include "Game/Render/TextureMipChain.hpp"
+
+/**
+ * @brief Statistics of the chunk texture cache.
+ */
+typedef struct {
+    //Number of chunks that currently have a texture
+    u64 cached;
+    //Maximum number of cached chunks at the current resolution
+    u64 capacity;
+    //Number of requests served from the cache
+    u64 hits;
+    //Number of chunks (re-)rendered into a texture
+    u64 renders;
+    //Number of textures taken over from other chunks
+    u64 evictions;
+    //Number of requests that could not be served at all
+    u64 overflows;
+    //Pixels per block of cached textures
+    u32 pixelsPerBlock;
+} ChunkTextureCacheStats;
+
+/**
+ * @brief A cache of chunks pre-rendered into target textures,
+ * so that a visible chunk can be drawn with a single copy
+ * instead of one copy per block.
+ *
+ * A cached texture is reused as long as the chunk's version
+ * stays the same, a changed chunk is rendered again into
+ * the texture it already has.
+ *
+ * All textures share a resolution of `pixelsPerBlock` pixels per block,
+ * a power of 2 no greater than `maxPixelsPerBlock`. Changing it
+ * drops the entire cache. Memory is bounded by `memoryBudget`:
+ * when it's exhausted, the texture of the chunk furthest away from
+ * the camera (least recently used if tied) is taken over.
+ * Chunks drawn in the current frame are never evicted.
+ */
+class ChunkTextureCache {
+    public:
+        //Highest resolution of cached textures, above that
+        //there are few enough blocks on screen to draw them directly
+        static constexpr u32 maxPixelsPerBlock = 16;
+    private:
+        typedef struct {
+            SDL_Texture* texture;
+            //Chunk the texture was rendered from, only used for comparison
+            const Chunk* chunk;
+            u32 version;
+            Structs::ChunkPos position;
+            //Frame this entry was last requested in
+            u64 lastUsedAt;
+        } Entry;
+
+        Entry* entries = nullptr;
+        u32 numberOfEntries = 0;
+        u32 capacity = 0;
+        u32 pixelsPerBlock = 0;
+        size_t memoryBudget;
+
+        ChunkMap<Entry> index;
+
+        //Indices of entries that may be taken over, the next one at the end
+        u32* evictionOrder = nullptr;
+        u32 numberOfEvictionCandidates = 0;
+        //Frame the eviction order was made in, 0 if it has to be made again
+        u64 evictionOrderFrame = 0;
+
+        //Atlas of block textures, used to draw a chunk in a single call
+        const TextureAtlas* atlas = nullptr;
+        //Downsampled block textures, the level matching the resolution
+        //is used instead of the atlas
+        const TextureMipChain* mips = nullptr;
+        TileBatch batch;
+
+        u64 currentFrame = 0;
+        Structs::ChunkPos cameraChunk = {0, 0};
+
+        u64 hits = 0;
+        u64 renders = 0;
+        u64 evictions = 0;
+        u64 overflows = 0;
+
+        Entry* __acquire(RenderCommandBuffer& commands, Structs::ChunkPos position);
+        void __orderForEviction();
+        void __render(RenderCommandBuffer& commands, Entry& entry, const Chunk& chunk);
+        void __destroyTextures(RenderCommandBuffer* commands);
+    public:
+        /**
+         * @brief Constructs an empty cache.
+         *
+         * @param memoryBudget maximum number of bytes
+         * taken by cached textures
+         */
+        explicit ChunkTextureCache(const size_t memoryBudget) : memoryBudget(memoryBudget), index(256) {}
+
+        ~ChunkTextureCache();
+
+        ChunkTextureCache(const ChunkTextureCache&) = delete;
+        ChunkTextureCache& operator=(const ChunkTextureCache&) = delete;
+
+        /**
+         * @brief Starts a new frame. Has to be called before
+         * requesting textures for the frame.
+         *
+         * @param commands buffer of the frame, textures of a different
+         * resolution are destroyed through it
+         * @param pixelsPerBlock current size of a block on screen,
+         * the resolution of cached textures is the lowest power of 2
+         * not smaller than it
+         * @param cameraChunk position of the chunk the camera is centered on,
+         * used for eviction
+         */
+        void beginFrame(RenderCommandBuffer& commands, u32 pixelsPerBlock, Structs::ChunkPos cameraChunk);
+
+        /**
+         * @brief Sets the atlas of block textures, with regions indexed
+         * by block IDs, used to render chunks.
+         * Blocks without a region in the atlas are copied one by one.
+         *
+         * @param atlas the atlas, nullptr to not use one
+         * @param mips downsampled block textures, also indexed by block IDs;
+         * if it has a level as big as a block in cached textures, blocks are
+         * drawn from it instead of being shrunk from the atlas
+         */
+        void setAtlas(const TextureAtlas* atlas, const TextureMipChain* mips = nullptr) {
+            this->atlas = atlas;
+            this->mips = mips;
+        }
+
+        /**
+         * @brief Get the texture of a chunk, rendering it first
+         * if it's not cached or it changed since it was cached.
+         *
+         * The texture is `16 * getPixelsPerBlock()` pixels wide and tall,
+         * its top row is the chunk's top (highest Y) row of blocks.
+         *
+         * @param commands buffer to record rendering of the chunk into,
+         * its target is restored
+         * @param position position of the chunk
+         * @param chunk the chunk
+         * @return SDL_Texture* or nullptr if the cache is full of chunks
+         * used in this frame or the texture could not be created,
+         * in which case the chunk should be drawn directly
+         */
+        SDL_Texture* get(RenderCommandBuffer& commands, Structs::ChunkPos position, const Chunk& chunk);
+
+        /**
+         * @brief Destroys every cached texture right away.
+         * No submitted frame may still be using them.
+         */
+        void clear();
+
+        /**
+         * @brief Get pixels per block of cached textures.
+         */
+        u32 getPixelsPerBlock() const { return this->pixelsPerBlock; }
+
+        /**
+         * @brief Get statistics of the cache.
+         */
+        ChunkTextureCacheStats getStats() const {
+            return {
+                this->numberOfEntries, this->capacity,
+                this->hits, this->renders, this->evictions, this->overflows,
+                this->pixelsPerBlock
+            };
+        }
+};
\ No newline at end of file
@@ -0,0 +1,288 @@
+#pragma once
+
+#include "Bindings.h"
+
+#include <cstdint>
+#include <unordered_map>
+
+#include <SDL_render.h>
+
+#include "deus.hpp"
+#include "DSA/Vector.hpp"
+#include "Game/Render/RenderCommandBuffer.hpp"
+#include "Game/Render/TextureAtlas.hpp"
+#include "resources.hpp"
+
+/**
+ * @brief A glyph rasterized into an atlas page.
+ */
+typedef struct {
+    //Region of the rasterized glyph, with no page if there is nothing to draw
+    AtlasRegion region;
+    //Size of the rasterized glyph, drawn with its upper-left corner
+    //at the pen position on the top of the line
+    i32 width;
+    i32 height;
+    //How far the pen moves after the glyph
+    i32 advance;
+} Glyph;
+
+/**
+ * @brief Statistics of glyph atlases.
+ */
+typedef struct {
+    //Number of glyphs rasterized so far
+    u64 glyphs;
+    //Number of atlas pages
+    u64 pages;
+    //Number of glyphs looked up while laying out text
+    u64 lookups;
+    //Number of lookups that had to rasterize the glyph
+    u64 misses;
+    //Number of quads drawn
+    u64 quads;
+} GlyphAtlasStats;
+
+/**
+ * @brief Glyphs of a single font, rasterized once in white when first
+ * used and packed into pages, from which text is laid out and drawn
+ * as textured quads colored by their vertices.
+ *
+ * Changing drawn text only costs new vertices, instead of rasterizing
+ * the whole string into a new texture. Every quad drawn with the atlas
+ * is collected and drawn with a single call per page by `flush()`.
+ *
+ * Glyphs are packed into shelves like in `TextureAtlas`, with a gap
+ * of 1 pixel. Pages are static textures and new glyphs are only
+ * written into parts of them no frame in flight draws from yet.
+ */
+class GlyphAtlas {
+    public:
+        static constexpr u32 numberOfAsciiGlyphs = 128;
+    private:
+        FontHandle font;
+        u32 pageSize;
+        Vector<SDL_Texture*> pages;
+        //Where the next glyph goes on the last page
+        u32 x = 0, y = 0, shelfHeight = 0;
+
+        //ASCII is looked up directly, everything else is hashed
+        Glyph ascii[numberOfAsciiGlyphs];
+        bool asciiRasterized[numberOfAsciiGlyphs] = {};
+        std::unordered_map<u32, Glyph> glyphs;
+
+        TileBatch batch;
+        GlyphAtlasStats stats = {};
+
+        bool __rasterize(RenderCommandBuffer& commands, TTF_Font* ttf, u32 codepoint, Glyph& glyph);
+        bool __addPage(RenderCommandBuffer& commands);
+        template<typename F>
+        Structs::Size __layout(RenderCommandBuffer& commands, const char* text, size_t length, u32 wrapLength, F&& emit);
+    public:
+        /**
+         * @brief Constructs an empty atlas.
+         *
+         * @param font handle to the font, obtained from
+         * `ResourceManager::loadFont(...)`
+         * @param pageSize width and height of every page
+         */
+        GlyphAtlas(const FontHandle font, const u32 pageSize) : font(font), pageSize(pageSize) {}
+
+        ~GlyphAtlas() { this->clear(); }
+
+        GlyphAtlas(const GlyphAtlas&) = delete;
+        GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+        /**
+         * @brief Decodes the UTF-8 character at `p` and moves past it.
+         * Invalid sequences decode to U+FFFD.
+         */
+        static ForceInline u32 decodeUTF8(const char*& p) {
+            const u8 c = (u8)*p++;
+            if(c < 0x80) Likely return c;
+
+            u32 codepoint, continuation;
+            if((c & 0xE0) == 0xC0) {
+                codepoint = c & 0x1F;
+                continuation = 1;
+            }
+            else if((c & 0xF0) == 0xE0) {
+                codepoint = c & 0x0F;
+                continuation = 2;
+            }
+            else if((c & 0xF8) == 0xF0) {
+                codepoint = c & 0x07;
+                continuation = 3;
+            }
+            else return 0xFFFD;
+
+            for(; continuation > 0; continuation--) {
+                //a truncated sequence, the next character starts here
+                if(((u8)*p & 0xC0) != 0x80) return 0xFFFD;
+                codepoint = (codepoint << 6) | ((u8)*p++ & 0x3F);
+            }
+            return codepoint;
+        }
+
+        /**
+         * @brief Get a glyph, rasterizing it if it wasn't yet.
+         *
+         * @param commands buffer of the frame being recorded
+         * @param codepoint Unicode code point of the glyph
+         * @return const Glyph* or nullptr if the font is invalid
+         * or the glyph could not be rasterized
+         */
+        const Glyph* getGlyph(RenderCommandBuffer& commands, u32 codepoint);
+
+        /**
+         * @brief Get the size of text, as it would be drawn.
+         *
+         * @param commands buffer of the frame being recorded
+         * @param text UTF-8 text, lines are broken at '\n'
+         * @param wrapLength width at which lines are wrapped between words, 0 for none
+         */
+        Structs::Size measure(RenderCommandBuffer& commands, const char* text, u32 wrapLength = 0);
+
+        /**
+         * @brief Lays out text and adds its glyphs to the batch
+         * drawn by `flush()`.
+         *
+         * @param commands buffer of the frame being recorded
+         * @param text UTF-8 text, lines are broken at '\n'
+         * @param position upper-left corner of the text on the rendering target
+         * @param color color of the text
+         * @param wrapLength width at which lines are wrapped between words, 0 for none
+         * @return size of the text
+         */
+        Structs::Size draw(
+            RenderCommandBuffer& commands, const char* text,
+            const SDL_FPoint position, const Structs::Color color, const u32 wrapLength = 0
+        ) {
+            return this->draw(commands, text, SIZE_MAX, position, color, wrapLength);
+        }
+
+        /**
+         * @brief Lays out at most `length` bytes of text and adds
+         * its glyphs to the batch drawn by `flush()`.
+         *
+         * @param commands buffer of the frame being recorded
+         * @param text UTF-8 text, lines are broken at '\n'
+         * @param length number of bytes of `text` to draw, it may end sooner
+         * @param position upper-left corner of the text on the rendering target
+         * @param color color of the text
+         * @param wrapLength width at which lines are wrapped between words, 0 for none
+         * @return size of the text
+         */
+        Structs::Size draw(
+            RenderCommandBuffer& commands, const char* text, size_t length,
+            SDL_FPoint position, Structs::Color color, u32 wrapLength = 0
+        );
+
+        /**
+         * @brief Get the distance between the tops of consecutive lines,
+         * 0 if the font is invalid.
+         */
+        i32 getLineSkip();
+
+        /**
+         * @brief Draws all text added since the last flush.
+         *
+         * @param commands buffer to record draw calls into
+         * @return number of draw calls made
+         */
+        u32 flush(RenderCommandBuffer& commands) {
+            return this->batch.flush(commands, this->pages.data(), (u32)this->pages.size());
+        }
+
+        /**
+         * @brief Destroys every page and forgets every glyph.
+         * Frames using the atlas must have been executed.
+         */
+        void clear();
+
+        FontHandle getFont() const { return this->font; }
+
+        GlyphAtlasStats getStats() const {
+            GlyphAtlasStats stats = this->stats;
+            stats.pages = this->pages.size();
+            return stats;
+        }
+};
+
+/**
+ * @brief Draws text with a glyph atlas per font, created when
+ * the font is first drawn with.
+ */
+class TextRenderer {
+    private:
+        //Indexed by font handles
+        Vector<GlyphAtlas*> atlases;
+        u32 pageSize;
+    public:
+        /**
+         * @brief Constructs a renderer with no atlases.
+         *
+         * @param pageSize width and height of atlas pages
+         */
+        explicit TextRenderer(const u32 pageSize) : pageSize(pageSize) {}
+
+        ~TextRenderer() { this->clear(); }
+
+        TextRenderer(const TextRenderer&) = delete;
+        TextRenderer& operator=(const TextRenderer&) = delete;
+
+        /**
+         * @brief Get the atlas of a font, creating it if there's none yet.
+         *
+         * @param font handle to the font
+         * @return GlyphAtlas* or nullptr if the font is invalid
+         */
+        GlyphAtlas* getAtlas(FontHandle font);
+
+        /**
+         * @brief Get the size of text, as it would be drawn.
+         *
+         * @param commands buffer of the frame being recorded
+         * @param font handle to the font
+         * @param text UTF-8 text, lines are broken at '\n'
+         * @param wrapLength width at which lines are wrapped between words, 0 for none
+         * @return size of the text, 0x0 if the font is invalid
+         */
+        Structs::Size measure(RenderCommandBuffer& commands, FontHandle font, const char* text, u32 wrapLength = 0);
+
+        /**
+         * @brief Lays out text to be drawn by the next `flush()`.
+         *
+         * @param commands buffer of the frame being recorded
+         * @param font handle to the font
+         * @param text UTF-8 text, lines are broken at '\n'
+         * @param position upper-left corner of the text on the rendering target
+         * @param color color of the text
+         * @param wrapLength width at which lines are wrapped between words, 0 for none
+         * @return size of the text, 0x0 if the font is invalid
+         */
+        Structs::Size draw(
+            RenderCommandBuffer& commands, FontHandle font, const char* text,
+            SDL_FPoint position, Structs::Color color, u32 wrapLength = 0
+        );
+
+        /**
+         * @brief Draws all text laid out since the last flush,
+         * one call per font and atlas page.
+         *
+         * @param commands buffer to record draw calls into
+         * @return number of draw calls made
+         */
+        u32 flush(RenderCommandBuffer& commands);
+
+        /**
+         * @brief Destroys every atlas.
+         * Frames using them must have been executed.
+         */
+        void clear();
+
+        /**
+         * @brief Get statistics of every atlas combined.
+         */
+        GlyphAtlasStats getStats() const;
+};
\ No newline at end of file
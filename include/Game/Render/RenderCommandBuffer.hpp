@@ -0,0 +1,205 @@
+#pragma once
+
+#include "Bindings.h"
+
+#include <SDL_render.h>
+
+#include "deus.hpp"
+#include "DSA/Vector.hpp"
+
+enum class RenderCommandType : u8 {
+    SET_TARGET,
+    SET_DRAW_COLOR,
+    CLEAR,
+    COPY,
+    GEOMETRY,
+    SET_TEXTURE_COLOR_MOD,
+    SET_TEXTURE_ALPHA_MOD,
+    SET_TEXTURE_BLEND_MODE,
+    DESTROY_TEXTURE,
+    PRESENT
+};
+
+typedef struct {
+    SDL_Rect source;
+    SDL_Rect target;
+    double angle;
+    SDL_RendererFlip flip;
+    //Whether `source` and `target` were given, if not the entire
+    //texture or rendering target is used
+    bool hasSource;
+    bool hasTarget;
+} RenderCopyCommand;
+
+typedef struct {
+    //Offsets into the buffer's vertex and index arrays
+    u32 firstVertex;
+    u32 numberOfVertices;
+    u32 firstIndex;
+    u32 numberOfIndices;
+} RenderGeometryCommand;
+
+/**
+ * @brief Counters of a recorded frame, to verify rendering
+ * optimizations by numbers. Counted when recording, so that they
+ * don't depend on when or where the frame is executed.
+ */
+typedef struct {
+    //Copies and geometry submissions
+    u64 drawCalls;
+    //Vertices of geometry submissions, 4 per copy
+    u64 vertices;
+    //Draw calls using a different texture than the previous one
+    u64 textureSwitches;
+    //Draw color changes
+    u64 drawColorChanges;
+    //Texture color modulation changes
+    u64 colorModChanges;
+    //Texture alpha modulation changes
+    u64 alphaChanges;
+    //Texture blend mode changes
+    u64 blendModeChanges;
+    //Rendering target changes
+    u64 targetSwitches;
+    //Textures created and destroyed through the buffer only;
+    //those of the resource manager and the texture loader aren't counted
+    u64 texturesCreated;
+    u64 texturesDestroyed;
+    //Visible chunks drawn, from cached textures, overview images or block by block
+    u64 tilesDrawn;
+    //Loaded chunks skipped for being out of view
+    u64 tilesCulled;
+    //Blocks drawn one by one or batched from the atlas
+    u64 blocksDrawn;
+} RenderStats;
+
+/**
+ * @brief A single recorded rendering operation.
+ */
+typedef struct {
+    RenderCommandType type;
+    //Texture the command uses or modifies, if any
+    SDL_Texture* texture;
+    union {
+        //SET_DRAW_COLOR, SET_TEXTURE_COLOR_MOD, SET_TEXTURE_ALPHA_MOD
+        SDL_Color color;
+        //SET_TEXTURE_BLEND_MODE
+        SDL_BlendMode blendMode;
+        //COPY
+        RenderCopyCommand copy;
+        //GEOMETRY
+        RenderGeometryCommand geometry;
+    };
+} RenderCommand;
+
+/**
+ * @brief Records the rendering operations of a frame, so that they
+ * can be executed later, possibly on another thread (see `RenderThread`).
+ *
+ * Methods mirror their SDL counterparts, except that nothing is drawn
+ * until `execute()`. Everything a command needs (rectangles, vertices, indices)
+ * is copied into the buffer, so it doesn't have to outlive recording.
+ * Textures are referenced and have to stay alive until the buffer is executed,
+ * which is why textures used during a frame are destroyed
+ * with `destroyTexture()` rather than directly.
+ *
+ * The rendering target and the draw color are tracked while recording,
+ * so they can be saved and restored without asking the rendering context.
+ */
+class RenderCommandBuffer {
+    private:
+        Vector<RenderCommand> commands;
+        Vector<SDL_Vertex> vertices;
+        Vector<int> indices;
+
+        //Rendering context textures are created with
+        SDL_Renderer* renderer = nullptr;
+        //State as of the last recorded command
+        SDL_Texture* target = nullptr;
+        SDL_Color drawColor = {0, 0, 0, 255};
+        //Texture of the last draw call
+        SDL_Texture* lastDrawnTexture = nullptr;
+
+        RenderStats stats = {};
+
+        void __countDraw(SDL_Texture* texture, u64 numberOfVertices);
+    public:
+        RenderCommandBuffer() : commands(1024), vertices(4096), indices(6144) {}
+
+        RenderCommandBuffer(const RenderCommandBuffer&) = delete;
+        RenderCommandBuffer& operator=(const RenderCommandBuffer&) = delete;
+
+        /**
+         * @brief Empties the buffer and starts recording a new frame.
+         * The target is assumed to be the default one.
+         *
+         * @param renderer rendering context the buffer will be executed with
+         */
+        void begin(SDL_Renderer* renderer);
+
+        /**
+         * @brief Executes every recorded command, in order, and empties the buffer.
+         * Holds `Program::getRenderingLock()` while doing so, except while
+         * presenting, so that other threads aren't held up by a slow present.
+         *
+         * @param renderer rendering context
+         */
+        void execute(SDL_Renderer* renderer);
+
+        /**
+         * @brief Creates a texture right away, while holding the rendering lock,
+         * since its size and format are usually needed to go on with recording.
+         * See `SDL_CreateTexture()`.
+         *
+         * @return SDL_Texture* or nullptr on failure
+         */
+        SDL_Texture* createTexture(u32 format, int access, int width, int height);
+
+        /**
+         * @brief Creates a static texture with the given contents right away,
+         * like `createTexture()`. See `SDL_UpdateTexture()`.
+         *
+         * @param pixels contents of the texture, in `format`
+         * @param pitch length of a row of `pixels` in bytes
+         * @return SDL_Texture* or nullptr on failure
+         */
+        SDL_Texture* createTexture(u32 format, int width, int height, const void* pixels, int pitch);
+
+        void setRenderTarget(SDL_Texture* texture);
+        void setRenderDrawColor(u8 red, u8 green, u8 blue, u8 alpha);
+        void renderClear();
+        void renderCopy(SDL_Texture* texture, const SDL_Rect* source, const SDL_Rect* target);
+        void renderCopyEx(
+            SDL_Texture* texture, const SDL_Rect* source, const SDL_Rect* target,
+            double angle, SDL_RendererFlip flip
+        );
+        void renderGeometry(
+            SDL_Texture* texture,
+            const SDL_Vertex* vertices, u32 numberOfVertices,
+            const int* indices, u32 numberOfIndices
+        );
+        void setTextureColorMod(SDL_Texture* texture, u8 red, u8 green, u8 blue);
+        void setTextureAlphaMod(SDL_Texture* texture, u8 alpha);
+        void setTextureBlendMode(SDL_Texture* texture, SDL_BlendMode blendMode);
+        /**
+         * @brief Destroys a texture after every command recorded before.
+         */
+        void destroyTexture(SDL_Texture* texture);
+        void renderPresent();
+
+        SDL_Texture* getRenderTarget() const { return this->target; }
+        SDL_Color getRenderDrawColor() const { return this->drawColor; }
+
+        SDL_Renderer* getRenderer() const { return this->renderer; }
+
+        /**
+         * @brief Get the number of recorded commands.
+         */
+        size_t size() const { return this->commands.size(); }
+
+        /**
+         * @brief Get counters of the commands recorded since `begin()`.
+         * Tile and block counters are left to the caller.
+         */
+        const RenderStats& getStats() const { return this->stats; }
+};
\ No newline at end of file
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "Bindings.h"
+
+#include <SDL_render.h>
+
+#include "deus.hpp"
+#include "DSA/Vector.hpp"
+#include "Game/Render/RenderCommandBuffer.hpp"
+
+/**
+ * @brief Statistics of a render target pool.
+ */
+typedef struct {
+    //Number of textures owned by the pool
+    u64 pooled;
+    //Number of textures currently handed out
+    u64 inUse;
+    //Number of requests served with an already existing texture
+    u64 hits;
+    //Number of requests that required creating a texture
+    u64 misses;
+    //Number of textures destroyed for being unused
+    u64 evictions;
+} RenderTargetPoolStats;
+
+/**
+ * @brief A pool of textures to be used as render targets
+ * (or any other kind of offscreen textures), so that they can be
+ * reused across frames instead of being created and destroyed every frame.
+ *
+ * Textures are matched by size, pixel format and access. A texture
+ * that isn't requested for `evictAfterFrames` frames is destroyed.
+ *
+ * Contents and state (blend mode, modulation) of a texture are not reset -
+ * they're whatever its last user left, so the texture should be
+ * cleared before drawing onto it.
+ */
+class RenderTargetPool {
+    private:
+        typedef struct {
+            SDL_Texture* texture;
+            int width;
+            int height;
+            u32 format;
+            int access;
+            bool inUse;
+            //Frame the texture was last handed out in
+            u64 lastUsedAt;
+        } Entry;
+
+        Vector<Entry> entries;
+        u64 evictAfterFrames;
+        u64 currentFrame = 0;
+
+        u64 hits = 0;
+        u64 misses = 0;
+        u64 evictions = 0;
+    public:
+        /**
+         * @brief Constructs an empty pool.
+         *
+         * @param evictAfterFrames number of frames after which
+         * an unused texture is destroyed
+         */
+        explicit RenderTargetPool(const u64 evictAfterFrames) : evictAfterFrames(evictAfterFrames) {}
+
+        ~RenderTargetPool() { this->clear(); }
+
+        RenderTargetPool(const RenderTargetPool&) = delete;
+        RenderTargetPool& operator=(const RenderTargetPool&) = delete;
+
+        /**
+         * @brief Hands out a texture, reusing a free one if possible.
+         * It has to be given back with `release()`.
+         *
+         * @param commands buffer of the current frame, used to create the texture
+         * @param width width of the texture
+         * @param height height of the texture
+         * @param format pixel format of the texture
+         * @param access texture access
+         * @return SDL_Texture* or nullptr if a texture could not be created
+         */
+        SDL_Texture* acquire(
+            RenderCommandBuffer& commands, const int width, const int height,
+            const u32 format = SDL_PIXELFORMAT_RGBA8888,
+            const int access = SDL_TEXTUREACCESS_TARGET
+        );
+
+        /**
+         * @brief Gives a texture back to the pool.
+         *
+         * @param texture texture obtained from `acquire()`,
+         * nullptr is ignored
+         */
+        void release(SDL_Texture* texture);
+
+        /**
+         * @brief Ends the current frame, destroying textures
+         * that weren't used for too long.
+         *
+         * @param commands buffer of the current frame,
+         * textures are destroyed once it's executed
+         */
+        void endFrame(RenderCommandBuffer& commands);
+
+        /**
+         * @brief Destroys every texture, including
+         * the ones currently handed out.
+         * No submitted frame may still be using them.
+         */
+        void clear();
+
+        /**
+         * @brief Get statistics of the pool.
+         */
+        RenderTargetPoolStats getStats() const;
+};
\ No newline at end of file
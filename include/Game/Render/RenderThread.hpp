@@ -0,0 +1,138 @@
+#pragma once
+
+#include "Bindings.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include <SDL_render.h>
+
+#include "deus.hpp"
+#include "Game/Render/RenderCommandBuffer.hpp"
+
+/**
+ * @brief Statistics of frame submission.
+ */
+typedef struct {
+    //Number of frames recorded and submitted
+    u64 submitted;
+    //Number of frames executed
+    u64 executed;
+    //Ticks it took to execute the last frame, including presenting it
+    u64 executionTime;
+    //Ticks the last recorded frame had to wait for a free buffer
+    u64 waitTime;
+    //Number of commands in the last executed frame
+    u64 commands;
+    //Whether frames are executed on a separate thread
+    bool threaded;
+} RenderThreadStats;
+
+/**
+ * @brief Executes recorded frames on a dedicated thread, so that
+ * the next frame can be simulated and recorded while the previous one
+ * is still being submitted and presented.
+ *
+ * Frames are recorded into one of `numberOfBuffers` command buffers,
+ * taken in turns. Recording a frame only has to wait when every other buffer
+ * is still queued or being executed, which bounds the latency to
+ * `numberOfBuffers - 1` frames.
+ *
+ * Only backends that tolerate being used from a thread other than
+ * the one that created them (with every call serialized by
+ * `Program::getRenderingLock()`) get a thread. With the others, or if
+ * the thread could not be started, frames are executed right when they're submitted.
+ *
+ * The thread is opt-in (`Program::setRenderThreadEnabled()`): it hasn't been
+ * verified on the Direct3D backends, where DXGI presents from a thread that
+ * doesn't own the window. Present may then need the window procedure, which
+ * runs on the main thread, while the main thread waits in `begin()`, `wait()`
+ * or on the rendering lock, which can deadlock. Window events that make the
+ * renderer update its viewport are also handled on the main thread
+ * without the rendering lock.
+ */
+class RenderThread {
+    public:
+        static constexpr u32 numberOfBuffers = 3;
+    private:
+        RenderCommandBuffer buffers[numberOfBuffers];
+        SDL_Renderer* renderer = nullptr;
+
+        std::thread thread;
+        std::mutex mutex;
+        //Signaled when a frame is submitted or the thread should stop
+        std::condition_variable submittedCondition;
+        //Signaled when a frame has been executed
+        std::condition_variable executedCondition;
+        bool threaded = false;
+        bool stopping = false;
+
+        u64 submitted = 0;
+        u64 executed = 0;
+        u64 executionTime = 0;
+        u64 waitTime = 0;
+        u64 commands = 0;
+
+        void __run();
+        //Executes a frame and counts it as executed
+        void __execute(RenderCommandBuffer& buffer);
+    public:
+        RenderThread() = default;
+
+        ~RenderThread() { this->stop(); }
+
+        RenderThread(const RenderThread&) = delete;
+        RenderThread& operator=(const RenderThread&) = delete;
+
+        /**
+         * @brief Whether a rendering context can be used
+         * from the render thread.
+         */
+        static bool isSupportedBy(SDL_Renderer* renderer);
+
+        /**
+         * @brief Starts executing frames for the given rendering context,
+         * on a separate thread if `threaded` and it's supported.
+         *
+         * @param renderer rendering context
+         * @param threaded whether to use a separate thread at all
+         * @return `Enums::Status::SUCCESS` on success,
+         *
+         * `Enums::Status::FAILURE` if the thread could not be started,
+         * in which case frames are executed when submitted.
+         */
+        Enums::Status start(SDL_Renderer* renderer, bool threaded = false);
+
+        /**
+         * @brief Executes every submitted frame and stops the thread.
+         */
+        void stop();
+
+        /**
+         * @brief Get a buffer to record the next frame into,
+         * waiting for one to become free if necessary.
+         */
+        RenderCommandBuffer& begin();
+
+        /**
+         * @brief Submits the frame recorded into the buffer from `begin()`.
+         */
+        void submit();
+
+        /**
+         * @brief Waits until every submitted frame has been executed.
+         * Has to be called before destroying textures the frames may use
+         * (other than with `RenderCommandBuffer::destroyTexture()`) and
+         * before using the rendering context directly. Must not be called
+         * while holding `Program::getRenderingLock()`.
+         */
+        void wait();
+
+        bool isThreaded() const { return this->threaded; }
+
+        /**
+         * @brief Get statistics of frame submission.
+         */
+        RenderThreadStats getStats();
+};
\ No newline at end of file
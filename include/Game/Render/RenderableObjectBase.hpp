@@ -18,6 +18,16 @@ class RenderableObjectBase : public GameObject {
 
     protected:
         TextureHandle textureHandle;
+
+        //Bumped whenever any renderable object changes
+        static u64 version;
+
+        /**
+         * @brief Marks that something about the object's looks changed.
+         * Subclasses modifying members directly have to call it,
+         * otherwise the renderer may skip drawing the change.
+         */
+        void __changed() { RenderableObjectBase::version++; }
     public:
         explicit RenderableObjectBase(const u32 objectID);
         explicit RenderableObjectBase(const u32 objectID, const char* name);
@@ -43,9 +53,9 @@ class RenderableObjectBase : public GameObject {
          * no texture is bound to it.
          */
         bool isVisible() const { return this->isFlagSet(1); }
-        void setVisible() { this->setFlag(1); }
-        void setInvisible() { this->clearFlag(1); }
-        void flipVisible() { this->flipFlag(1); }
+        void setVisible() { this->setFlag(1); this->__changed(); }
+        void setInvisible() { this->clearFlag(1); this->__changed(); }
+        void flipVisible() { this->flipFlag(1); this->__changed(); }
 
         /**
          * @brief Get the texture bound to this object.
@@ -64,4 +74,10 @@ class RenderableObjectBase : public GameObject {
          */
         RenderableObjectBase& bindTexture(TextureHandle textureHandle);
 
+        /**
+         * @brief Get a number that changes whenever
+         * any renderable object changes.
+         */
+        static u64 getVersion() { return RenderableObjectBase::version; }
+
 };
\ No newline at end of file
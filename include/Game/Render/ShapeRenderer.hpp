@@ -0,0 +1,215 @@
+#pragma once
+
+#include "Bindings.h"
+
+#include <SDL_render.h>
+
+#include <unordered_map>
+
+#include "deus.hpp"
+#include "DSA/Vector.hpp"
+#include "Game/Render/RenderCommandBuffer.hpp"
+
+/**
+ * @brief Statistics of a single frame of a shape renderer.
+ */
+typedef struct {
+    //Number of shapes drawn
+    u64 shapes;
+    //Number of shapes whose tessellation was taken from the cache
+    u64 cacheHits;
+    //Number of SDL_RenderGeometry calls
+    u64 drawCalls;
+    //Number of vertices submitted
+    u64 vertices;
+    //Number of tessellations currently cached
+    u64 cached;
+} ShapeRendererStats;
+
+/**
+ * @brief Tessellates arcs, circles, ellipses, lines and polygons into
+ * a shared vertex and index buffer, drawn with a single
+ * `SDL_RenderGeometry` call for every run of shapes using the same texture.
+ *
+ * Shapes are drawn in the order they were added - the buffer is flushed
+ * whenever a shape with a different texture is added, when the rendering
+ * target changes (call `flush()` before changing it) and at `flush()`.
+ *
+ * Points of arcs are taken from unit circle tables shared by every
+ * arc with the same number of segments and scaled in bulk.
+ * Tessellations of arcs are cached and reused as long as the same
+ * arc keeps being drawn, those not drawn for a while are dropped in `endFrame()`.
+ */
+class ShapeRenderer {
+    private:
+        typedef struct {
+            u32 segments;
+            //sin and cos of every angle, from 0 to 360 degrees inclusive
+            float* sin;
+            float* cos;
+        } UnitCircle;
+
+        //Everything that determines an arc's tessellation
+        typedef struct {
+            float centerX, centerY;
+            float radiusX, radiusY;
+            double start, end;
+            Structs::Color centerColor, outerColor;
+            SDL_Texture* texture;
+            float textureCenterX, textureCenterY;
+            u32 segments;
+        } ArcKey;
+
+        typedef struct {
+            size_t operator()(const ArcKey& key) const noexcept;
+        } ArcKeyHash;
+
+        typedef struct {
+            bool operator()(const ArcKey& a, const ArcKey& b) const noexcept;
+        } ArcKeyEqual;
+
+        typedef struct {
+            Vector<SDL_Vertex> vertices;
+            Vector<int> indices;
+            u64 lastUsedAt;
+        } CachedArc;
+
+        RenderCommandBuffer* commands;
+        //Texture of the shapes currently in the buffer
+        SDL_Texture* currentTexture = nullptr;
+        Vector<SDL_Vertex> vertices;
+        Vector<int> indices;
+
+        Vector<UnitCircle> unitCircles;
+        //Scratch space for transforming unit circle points
+        Vector<float> scratchX;
+        Vector<float> scratchY;
+
+        std::unordered_map<ArcKey, CachedArc, ArcKeyHash, ArcKeyEqual> arcCache;
+        u64 evictAfterFrames;
+        u64 currentFrame = 0;
+
+        //Statistics of the current and the last finished frame
+        ShapeRendererStats stats = {};
+        ShapeRendererStats lastFrameStats = {};
+
+        const UnitCircle& __unitCircle(u32 segments);
+        void __use(SDL_Texture* texture);
+        void __append(const SDL_Vertex* v, u32 numberOfVertices, const int* i, u32 numberOfIndices);
+        void __tessellateArc(const ArcKey& key, float invW, float invH, CachedArc& out);
+    public:
+        /**
+         * @brief Constructs a shape renderer.
+         *
+         * @param evictAfterFrames number of frames after which
+         * a cached arc tessellation that wasn't used is dropped
+         */
+        explicit ShapeRenderer(const u64 evictAfterFrames) : commands(nullptr), evictAfterFrames(evictAfterFrames) {}
+
+        ~ShapeRenderer();
+
+        ShapeRenderer(const ShapeRenderer&) = delete;
+        ShapeRenderer& operator=(const ShapeRenderer&) = delete;
+
+        /**
+         * @brief Sets the command buffer shapes are recorded into.
+         * Flushes pending shapes if it's different from the current one.
+         */
+        void setCommandBuffer(RenderCommandBuffer* commands);
+
+        /**
+         * @brief Picks a number of segments for a full circle
+         * of a given radius, so that no segment is longer than a few pixels.
+         */
+        static u32 segmentsFor(const float radius);
+
+        /**
+         * @brief Adds an arc.
+         * Used for drawing circular and elliptical arcs, as well as
+         * circles and ellipses.
+         * To draw a circular arc, set `rX` equal to `rY`.
+         *
+         * @param center point around which the arc will be drawn
+         * @param rX horizontal radius of the arc
+         * @param rY vertical radius of the arc
+         * @param start start of the arc in degrees, automatically clamped to [0, 360] degrees
+         * @param end end of the arc in degrees, automatically clamped to [0, 360] degrees;
+         * draws counterclockwise if `end < start`
+         * @param centerColor color of the central point
+         * @param outerColor color of outer points; if `outerColor` is different than
+         * `centerColor` a gradient is applied between them
+         * @param srcTex (optional) texture to copy pixel data from, if
+         * `centerColor` and `outerColor` are not white, a mask from these colors is applied
+         * @param srcTexCenter (optional) center point of the part of `srcTex`
+         * to copy
+         * @param segments number of segments a full circle would have,
+         * 0 to pick it based on the radius
+         */
+        void arc(
+            Structs::PointF center, float rX, float rY,
+            double start, double end, Structs::Color centerColor, Structs::Color outerColor,
+            SDL_Texture* srcTex = nullptr, Structs::PointF srcTexCenter = {0.0f, 0.0f},
+            u32 segments = 0
+        );
+
+        /**
+         * @brief Adds a circle. See `arc()`.
+         */
+        void circle(
+            Structs::PointF center, float r,
+            Structs::Color centerColor, Structs::Color outerColor,
+            SDL_Texture* srcTex = nullptr, Structs::PointF srcTexCenter = {0.0f, 0.0f}
+        ) {
+            this->arc(center, r, r, 0.0, 360.0, centerColor, outerColor, srcTex, srcTexCenter);
+        }
+
+        /**
+         * @brief Adds an ellipse. See `arc()`.
+         */
+        void ellipse(
+            Structs::PointF center, float rX, float rY,
+            Structs::Color centerColor, Structs::Color outerColor,
+            SDL_Texture* srcTex = nullptr, Structs::PointF srcTexCenter = {0.0f, 0.0f}
+        ) {
+            this->arc(center, rX, rY, 0.0, 360.0, centerColor, outerColor, srcTex, srcTexCenter);
+        }
+
+        /**
+         * @brief Adds a line of given thickness.
+         *
+         * @param from start of the line
+         * @param to end of the line
+         * @param thickness thickness in pixels
+         * @param fromColor color at the start
+         * @param toColor color at the end, a gradient is applied between them
+         */
+        void line(
+            Structs::PointF from, Structs::PointF to, float thickness,
+            Structs::Color fromColor, Structs::Color toColor
+        );
+
+        /**
+         * @brief Adds a filled convex polygon.
+         *
+         * @param points vertices of the polygon, in order
+         * @param numberOfPoints number of vertices, at least 3
+         * @param color color of the polygon
+         */
+        void polygon(const Structs::PointF* points, u32 numberOfPoints, Structs::Color color);
+
+        /**
+         * @brief Draws every pending shape.
+         */
+        void flush();
+
+        /**
+         * @brief Ends the current frame, dropping cached
+         * tessellations that weren't used for too long.
+         */
+        void endFrame();
+
+        /**
+         * @brief Get statistics of the last finished frame.
+         */
+        const ShapeRendererStats& getStats() const { return this->lastFrameStats; }
+};
\ No newline at end of file
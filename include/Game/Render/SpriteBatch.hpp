@@ -0,0 +1,124 @@
+#pragma once
+
+#include "Bindings.h"
+
+#include <SDL_render.h>
+#include <unordered_map>
+#include <vector>
+
+#include "deus.hpp"
+#include "DSA/Vector.hpp"
+#include "Game/Render/RenderCommandBuffer.hpp"
+
+/**
+ * @brief A single textured rectangle to draw.
+ */
+typedef struct {
+    SDL_Texture* texture;
+    //Portion of the texture to use
+    SDL_Rect source;
+    //Portion of the rendering target to fill
+    SDL_Rect target;
+    double angle;
+    SDL_RendererFlip flip;
+    Structs::Color modulation;
+    SDL_BlendMode blendMode;
+    //Sprites in lower layers are always drawn first
+    i32 layer;
+} Sprite;
+
+/**
+ * @brief Statistics of the last flushed frame of a sprite batch.
+ */
+typedef struct {
+    //Number of sprites drawn
+    u64 sprites;
+    //Number of SDL_SetTextureColorMod calls
+    u64 colorModChanges;
+    //Number of SDL_SetTextureAlphaMod calls
+    u64 alphaModChanges;
+    //Number of SDL_SetTextureBlendMode calls
+    u64 blendModeChanges;
+    //Number of state changes that were skipped since the state was already applied
+    u64 redundantChanges;
+    //Number of state changes made to restore textures to their original state
+    u64 restores;
+} SpriteBatchStats;
+
+/**
+ * @brief Collects sprites over a frame and draws them sorted by
+ * (layer, texture, blend mode, modulation), so that sprites sharing
+ * the same texture and state are drawn one after another.
+ *
+ * Draw order is preserved where it matters: sprites in lower layers
+ * are drawn first and a sprite overlapping an earlier one in the same
+ * layer is drawn after it. Only sprites that don't overlap are
+ * reordered.
+ *
+ * The modulation and blend mode of every texture are queried the first
+ * time it's drawn in a flush (PNGs with alpha, for example, start out
+ * blended). The state applied to every texture is tracked, so a state change
+ * is only made if the texture doesn't have it yet, and every modified texture
+ * is restored to the queried state once, at the end of the flush.
+ */
+class SpriteBatch {
+    private:
+        typedef struct {
+            Sprite sprite;
+            //Bounding box of the sprite on the target, accounts for rotation
+            SDL_Rect bounds;
+            //Sprites of greater depth have to be drawn after this one
+            u32 depth;
+            //Order of submission
+            u32 order;
+        } Item;
+
+        typedef struct {
+            SDL_Texture* texture;
+            //State applied last
+            Structs::Color modulation;
+            SDL_BlendMode blendMode;
+            //State it had before the flush
+            Structs::Color originalModulation;
+            SDL_BlendMode originalBlendMode;
+        } TextureState;
+
+        Vector<Item> items;
+        Vector<TextureState> states;
+        //Indices into `states`, by texture
+        std::unordered_map<SDL_Texture*, u32> stateIndices;
+        SpriteBatchStats stats = {};
+
+        //Sprites by the cells of a coarse grid over the target they cover,
+        //in order of submission: the sprites of cell c are
+        //`cellItems[cellStarts[c]]` to `cellItems[cellStarts[c + 1] - 1]`
+        std::vector<u32> cellStarts;
+        std::vector<u32> cellItems;
+        //Last sprite an earlier sprite was compared with, so pairs
+        //sharing several cells are only compared once
+        std::vector<u32> comparedWith;
+
+        void __computeDepths();
+        TextureState& __stateOf(SDL_Texture* texture);
+    public:
+        SpriteBatch() = default;
+
+        /**
+         * @brief Adds a sprite to draw in the next flush.
+         *
+         * @param sprite sprite, nullptr textures are ignored
+         */
+        void add(const Sprite& sprite);
+
+        /**
+         * @brief Draws every collected sprite and empties the batch.
+         *
+         * @param commands buffer to record draw calls into
+         */
+        void flush(RenderCommandBuffer& commands);
+
+        /**
+         * @brief Get statistics of the last flush.
+         */
+        const SpriteBatchStats& getStats() const { return this->stats; }
+};
\ No newline at end of file
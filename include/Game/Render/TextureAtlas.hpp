@@ -0,0 +1,142 @@
+#pragma once
+
+#include "Bindings.h"
+
+#include <SDL_render.h>
+
+#include "deus.hpp"
+#include "DSA/Vector.hpp"
+#include "Game/Render/RenderCommandBuffer.hpp"
+
+/**
+ * @brief Location of a texture packed into an atlas.
+ */
+typedef struct {
+    //Page the texture was packed into, nullptr if it couldn't be
+    SDL_Texture* page;
+    u32 pageIndex;
+    //Normalized texture coordinates of the upper-left corner
+    SDL_FPoint min;
+    //Normalized texture coordinates of the lower-right corner
+    SDL_FPoint max;
+} AtlasRegion;
+
+/**
+ * @brief A set of large target textures (pages), with many
+ * small textures copied into them, so that things drawn
+ * with different textures can be drawn with a single call.
+ *
+ * Textures are packed in rows (shelves) from left to right,
+ * starting a new page when one fills up.
+ * There is a 1 pixel gap between packed textures and texture
+ * coordinates are pulled half a texel inwards, so that
+ * neighbouring textures never bleed into each other.
+ */
+class TextureAtlas {
+    private:
+        Vector<SDL_Texture*> pages;
+        Vector<AtlasRegion> regions;
+        u32 pageSize;
+    public:
+        /**
+         * @brief Constructs an empty atlas.
+         *
+         * @param pageSize width and height of every page, clamped
+         * to the maximum texture size supported by the renderer
+         */
+        explicit TextureAtlas(const u32 pageSize) : pageSize(pageSize) {}
+
+        ~TextureAtlas() { this->clear(); }
+
+        TextureAtlas(const TextureAtlas&) = delete;
+        TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+        /**
+         * @brief (Re)builds the atlas from the given textures.
+         * Region `i` corresponds to `textures[i]`.
+         *
+         * Textures that are nullptr or bigger than a page
+         * get a region with no page.
+         *
+         * @param renderer rendering context, its target is restored
+         * @param count number of textures
+         * @param textures textures to pack
+         * @return `Enums::Status::SUCCESS` on success,
+         *
+         * `Enums::Status::SDL_TEXTURE_CREATION_FAILURE` if a page could not be created,
+         * in which case the atlas is left empty.
+         */
+        Enums::Status build(SDL_Renderer* renderer, const u32 count, SDL_Texture* const* textures);
+
+        /**
+         * @brief Destroys every page.
+         */
+        void clear();
+
+        /**
+         * @brief Get region of the texture with given index.
+         *
+         * @param index index of the texture passed to `build()`
+         * @return const AtlasRegion* or nullptr if there is no such texture
+         */
+        const AtlasRegion* getRegion(const u32 index) const {
+            if(index >= this->regions.size()) return nullptr;
+            return &this->regions[index];
+        }
+
+        SDL_Texture* getPage(const u32 index) const { return this->pages[index]; }
+        SDL_Texture* const* getPages() const { return this->pages.data(); }
+
+        u32 getNumberOfPages() const { return (u32)this->pages.size(); }
+};
+
+/**
+ * @brief Collects textured quads using atlas regions,
+ * and draws all of them with one `SDL_RenderGeometry`
+ * call per atlas page.
+ */
+class TileBatch {
+    private:
+        //One vertex array per atlas page
+        Vector<Vector<SDL_Vertex>> vertices;
+        //Shared by every page, since every quad uses the same pattern
+        Vector<int> indices;
+    public:
+        TileBatch() = default;
+
+        /**
+         * @brief Adds a quad covering `target`.
+         *
+         * @param region region of the atlas to draw, must have a page
+         * @param target rectangle on the rendering target
+         * @param color color the texture is multiplied with
+         */
+        void addQuad(const AtlasRegion& region, const SDL_FRect& target, const SDL_Color color = {255, 255, 255, 255}) {
+            while(this->vertices.size() <= region.pageIndex) this->vertices.emplaceBack();
+            Vector<SDL_Vertex>& v = this->vertices[region.pageIndex];
+
+            v.append({{target.x, target.y}, color, {region.min.x, region.min.y}});
+            v.append({{target.x + target.w, target.y}, color, {region.max.x, region.min.y}});
+            v.append({{target.x + target.w, target.y + target.h}, color, {region.max.x, region.max.y}});
+            v.append({{target.x, target.y + target.h}, color, {region.min.x, region.max.y}});
+        }
+
+        /**
+         * @brief Draws every collected quad and empties the batch.
+         *
+         * @param commands buffer to record draw calls into
+         * @param atlas atlas the regions come from
+         * @return number of draw calls made
+         */
+        u32 flush(RenderCommandBuffer& commands, const TextureAtlas& atlas);
+
+        /**
+         * @brief Draws every collected quad and empties the batch.
+         *
+         * @param commands buffer to record draw calls into
+         * @param pages pages the regions' indices refer to
+         * @param numberOfPages number of pages
+         * @return number of draw calls made
+         */
+        u32 flush(RenderCommandBuffer& commands, SDL_Texture* const* pages, u32 numberOfPages);
+};
\ No newline at end of file
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Bindings.h"
+
+#include <SDL_render.h>
+
+#include "deus.hpp"
+#include "DSA/Vector.hpp"
+#include "Game/Render/TextureAtlas.hpp"
+
+/**
+ * @brief Downsampled copies of a set of square textures of the same size,
+ * halved at every level down to 1x1 pixel, with every level packed
+ * into an atlas of its own, and the average color of every texture.
+ *
+ * Drawing a texture from the level matching the size it's drawn at
+ * copies it 1:1 instead of sampling a few of its pixels, which is
+ * both faster and doesn't shimmer. Every level is rendered from
+ * the previous one at half the size with linear filtering,
+ * so every pixel is the average of the 2x2 pixels above it and
+ * the last level holds the average color of the whole texture.
+ */
+class TextureMipChain {
+    public:
+        //Enough for textures up to 4096x4096
+        static constexpr u32 maxLevels = 12;
+    private:
+        //Level `i` holds textures `size >> (i + 1)` pixels wide
+        TextureAtlas* levels[maxLevels] = {};
+        u32 numberOfLevels = 0;
+        u32 size = 0;
+        u32 pageSize;
+        //Indexed like the textures passed to `build()`
+        Vector<SDL_Color> averageColors;
+    public:
+        /**
+         * @brief Constructs an empty chain.
+         *
+         * @param pageSize width and height of atlas pages
+         */
+        explicit TextureMipChain(const u32 pageSize) : pageSize(pageSize) {}
+
+        ~TextureMipChain() { this->clear(); }
+
+        TextureMipChain(const TextureMipChain&) = delete;
+        TextureMipChain& operator=(const TextureMipChain&) = delete;
+
+        /**
+         * @brief (Re)builds every level from the given textures.
+         * Region `i` of every level and average color `i` correspond to `textures[i]`.
+         * Textures that are nullptr get no region and a transparent color.
+         *
+         * @param renderer rendering context, its target is restored
+         * @param count number of textures
+         * @param textures textures to downsample, stretched to `size` if they differ
+         * @param size width and height of the textures, a power of 2
+         * @return `Enums::Status::SUCCESS` on success,
+         *
+         * `Enums::Status::SDL_TEXTURE_CREATION_FAILURE` if a texture could not be created,
+         * in which case the chain is left empty.
+         */
+        Enums::Status build(SDL_Renderer* renderer, u32 count, SDL_Texture* const* textures, u32 size);
+
+        /**
+         * @brief Destroys every level.
+         */
+        void clear();
+
+        /**
+         * @brief Get the level in which textures are the given size.
+         *
+         * @param pixels width of a texture at that level, a power of 2
+         * @return const TextureAtlas* or nullptr if there is no such level
+         */
+        const TextureAtlas* getLevel(u32 pixels) const;
+
+        /**
+         * @brief Get the average color of a texture.
+         *
+         * @param index index of the texture passed to `build()`
+         * @return its color, transparent if there is no such texture
+         */
+        SDL_Color getAverageColor(const u32 index) const {
+            if(index >= this->averageColors.size()) return {0, 0, 0, 0};
+            return this->averageColors[index];
+        }
+
+        u32 getNumberOfLevels() const { return this->numberOfLevels; }
+
+        bool isEmpty() const { return this->numberOfLevels == 0; }
+};
\ No newline at end of file
@@ -13,6 +13,20 @@
  */
 class UIElement : public RenderableObject {
     friend class GameRenderer;
+    protected:
+        /**
+         * @brief Elements in lower layers are drawn first,
+         * elements in higher layers are drawn on top of them.
+         */
+        i32 layer = 0;
+        /**
+         * @brief `targetPortion` as of the start of the latest
+         * simulation tick. The element is drawn between it and
+         * `targetPortion`, depending on how far into the next tick a frame is.
+         */
+        SDL_Rect previousTargetPortion = {0, 0, 0, 0};
+        //Whether `previousTargetPortion` was ever set
+        bool hasPreviousTargetPortion = false;
     public:
         explicit UIElement(const u32 objectID);
         explicit UIElement(const u32 objectID, const char* name);
@@ -25,8 +39,28 @@ class UIElement : public RenderableObject {
         virtual void onKeyPress(SDL_Keycode key);
         virtual void onMouseClick(uint8_t button);
 
+        /**
+         * @brief Advances the element by one simulation tick.
+         * Anything that changes over time belongs here rather than
+         * in `render()`, which runs once per frame.
+         */
+        virtual void update();
+
         virtual void render() override;
 
+        /**
+         * @brief Sets the layer the element is drawn in.
+         * 
+         * Elements in the same layer are drawn in the order they were
+         * created in only if they overlap, otherwise the renderer may
+         * reorder them to reduce texture state changes.
+         * 
+         * @param layer the layer, 0 by default
+         * @return this, for chaining
+         */
+        UIElement& setLayer(const i32 layer) { this->layer = layer; this->__changed(); return *this; }
+        i32 getLayer() const { return this->layer; }
+
         static UIElement& createUIElement(const u32 objectID);
         static UIElement& createUIElement(const u32 objectID, const char* name);
         static UIElement& createUIElement(const u32 objectID, const TextureHandle textureHandle);
@@ -1,21 +1,195 @@
 #pragma once
 
-//TODO: finish implementing a renderable static text box
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "Game/Render/GlyphAtlas.hpp"
 #include "Game/Render/UIElement.hpp"
 
+/**
+ * @brief Position in the text of a `UITextElement`.
+ */
+typedef struct {
+    //Index of the paragraph, i.e. of the line before wrapping
+    u32 paragraph;
+    //Byte offset into the paragraph's UTF-8 text
+    u32 offset;
+} TextPosition;
+
 /**
  * @brief A UITextElement is an element
  * of a UI which contains logic for
- * rendering non-modifiable text boxes.
+ * rendering editable text boxes, e.g. consoles and chats.
+ *
+ * The text is kept as paragraphs (lines separated by '\n'),
+ * each with its own cache of where it's wrapped to the element's width.
+ * Editing the text only rewraps the paragraphs it touched and
+ * appending to the end only ever rewraps the last one.
+ * Only lines in view are laid out each frame, from glyph atlases,
+ * so scrolling through thousands of them costs the same as through a few.
+ *
+ * Text elements are drawn on top of every other UI element.
+ * Try not to create them with a constructor as
+ * it will not be hooked to the game's renderer.
+ * Use `createUITextElement` instead.
  */
-class UITextElement : UIElement {
+class UITextElement : public UIElement {
+    friend class GameRenderer;
+    private:
+        struct Paragraph {
+            std::string text;
+            //Byte offsets at which wrapped lines start, the first is always 0
+            std::vector<u32> lineStarts;
+            //Index of the first wrapped line, including every line dropped so far
+            u64 firstLine = 0;
+            //Whether `lineStarts` is up to date
+            bool wrapped = false;
+        };
+
+        std::deque<Paragraph> paragraphs;
+        FontHandle font;
+        Structs::Color textColor = Structs::Colors::WHITE;
+        //Paragraphs before this one have up to date `firstLine`s
+        u32 firstOutdatedParagraph = 0;
+        //Width the paragraphs were wrapped at
+        i32 wrappedAt = 0;
+        //Lines of paragraphs dropped from the front
+        u64 linesDropped = 0;
+        //Wrapped lines as of the latest layout
+        u64 numberOfLines = 0;
+        //Oldest paragraphs are dropped above this, 0 for no limit
+        u32 maxParagraphs = 0;
+
+        //First line in view
+        u64 scrollLine = 0;
+        //Lines fitting into the element, as of the latest frame
+        u32 linesInView = 0;
+        //Whether the view follows the end of the text as it grows
+        bool followingEnd = true;
+
+        void __outdate(u32 paragraph);
+        void __dropParagraphs();
+        void __wrap(GlyphAtlas& atlas, RenderCommandBuffer& commands, Paragraph& paragraph, i32 width);
+        void __layout(GlyphAtlas& atlas, RenderCommandBuffer& commands);
+        void __draw(TextRenderer& text, RenderCommandBuffer& commands);
     public:
-        UITextElement(const u32 objectID);
-        UITextElement(const u32 objectID, const char* name);
-        UITextElement(const u32 objectID, const TextureHandle textureHandle);
-        UITextElement(const u32 objectID, const char* name, const TextureHandle textureHandle);
+        explicit UITextElement(const u32 objectID, const FontHandle font);
+        explicit UITextElement(const u32 objectID, const char* name, const FontHandle font);
 
         ~UITextElement() = default;
 
+        //Text elements stay where they're put
+        void update() override {}
+
+        /**
+         * @brief Appends text to the end, '\n' starts a new paragraph.
+         *
+         * @param text UTF-8 text
+         * @return this, for chaining
+         */
+        UITextElement& append(const char* text);
+
+        /**
+         * @brief Appends text as a new paragraph after the last one,
+         * e.g. a line of a log.
+         *
+         * @param text UTF-8 text, '\n' starts further paragraphs
+         * @return this, for chaining
+         */
+        UITextElement& appendLine(const char* text);
+
+        /**
+         * @brief Inserts text at a position, '\n' splits the paragraph.
+         *
+         * @param at position to insert at, clamped to the text
+         * @param text UTF-8 text
+         * @return this, for chaining
+         */
+        UITextElement& insert(TextPosition at, const char* text);
+
+        /**
+         * @brief Erases text between two positions, joining
+         * the paragraphs they're in.
+         *
+         * @param from first position erased, clamped to the text
+         * @param to position after the last one erased, clamped to the text
+         * @return this, for chaining
+         */
+        UITextElement& erase(TextPosition from, TextPosition to);
+
+        /**
+         * @brief Erases all text.
+         *
+         * @return this, for chaining
+         */
+        UITextElement& clear();
+
+        u32 getNumberOfParagraphs() const { return (u32)this->paragraphs.size(); }
+        const std::string& getParagraph(const u32 index) const { return this->paragraphs[index].text; }
+
+        /**
+         * @brief Get the position after the last character.
+         */
+        TextPosition getEnd() const {
+            if(this->paragraphs.empty()) return {0, 0};
+            return {(u32)this->paragraphs.size() - 1, (u32)this->paragraphs.back().text.size()};
+        }
+
+        /**
+         * @brief Sets how many paragraphs are kept, dropping
+         * the oldest ones above it.
+         *
+         * @param maxParagraphs number of paragraphs, 0 for no limit
+         * @return this, for chaining
+         */
+        UITextElement& setMaxParagraphs(u32 maxParagraphs);
+
+        UITextElement& setTextColor(const Structs::Color color) { this->textColor = color; this->__changed(); return *this; }
+        Structs::Color getTextColor() const { return this->textColor; }
+
+        /**
+         * @brief Sets the font, rewrapping every paragraph.
+         *
+         * @param font handle to the font, obtained from
+         * `ResourceManager::loadFont(...)`
+         * @return this, for chaining
+         */
+        UITextElement& setFont(FontHandle font);
+        FontHandle getFont() const { return this->font; }
+
+        /**
+         * @brief Scrolls so that the given wrapped line is the first in view.
+         * The view stops following the end of the text.
+         *
+         * @param line index of the line, clamped to the text
+         * @return this, for chaining
+         */
+        UITextElement& scrollTo(u64 line);
+
+        /**
+         * @brief Scrolls by a number of wrapped lines,
+         * following the end of the text again once it's reached.
+         *
+         * @param lines number of lines, negative to scroll up
+         * @return this, for chaining
+         */
+        UITextElement& scrollBy(i64 lines);
+
+        /**
+         * @brief Scrolls to the end of the text and keeps following it.
+         *
+         * @return this, for chaining
+         */
+        UITextElement& scrollToEnd();
+
+        u64 getScrollLine() const { return this->scrollLine; }
+
+        /**
+         * @brief Get the number of wrapped lines, as of the latest frame.
+         */
+        u64 getNumberOfLines() const { return this->numberOfLines; }
 
+        static UITextElement& createUITextElement(const u32 objectID, const FontHandle font);
+        static UITextElement& createUITextElement(const u32 objectID, const char* name, const FontHandle font);
 };
\ No newline at end of file
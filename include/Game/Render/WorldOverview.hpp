@@ -0,0 +1,145 @@
+#pragma once
+
+#include "Bindings.h"
+
+#include <SDL_render.h>
+
+#include "deus.hpp"
+#include "DSA/ChunkMap.hpp"
+#include "DSA/Vector.hpp"
+#include "Game/Chunk.hpp"
+#include "Game/Render/RenderCommandBuffer.hpp"
+#include "Game/Render/TextureMipChain.hpp"
+#include "Game/World.hpp"
+
+/**
+ * @brief Statistics of the world overview.
+ */
+typedef struct {
+    //Number of regions that currently have a texture
+    u64 cached;
+    //Maximum number of cached regions
+    u64 capacity;
+    //Number of requests served from the cache
+    u64 hits;
+    //Number of region images generated
+    u64 builds;
+    //Number of textures taken over from other regions
+    u64 evictions;
+    //Number of requests that could not be served at all
+    u64 overflows;
+} WorldOverviewStats;
+
+/**
+ * @brief Images of the world at one pixel per block, in the block's
+ * average color, for when blocks are too small on screen
+ * to show anything more.
+ *
+ * The world is split into square regions of `regionSize` chunks,
+ * each generated on the CPU into a texture of its own, so that drawing
+ * takes one copy per region on screen, however many blocks are in it.
+ * A region is generated again when any of its chunks changes.
+ * When all `capacity` textures are taken, the least recently used region
+ * not drawn in the current frame gives up its texture.
+ */
+class WorldOverview {
+    public:
+        //Width and height of a region in chunks
+        static constexpr u32 regionSize = 8;
+        //Width and height of a region's image, one pixel per block
+        static constexpr u32 regionPixels = regionSize * Chunk::size;
+        //Highest size of a block on screen the overview is drawn at
+        static constexpr u32 maxPixelsPerBlock = 4;
+    private:
+        typedef struct {
+            SDL_Texture* texture;
+            Structs::ChunkPos position;
+            //Sum of versions of the chunks the image was generated from
+            u64 versionSum;
+            u32 numberOfChunks;
+            //Frame this entry was last requested in
+            u64 lastUsedAt;
+        } Entry;
+
+        Vector<Entry> entries;
+        ChunkMap<Entry> index;
+        u32 capacity;
+        u64 currentFrame = 0;
+
+        SDL_Color pixels[regionPixels * regionPixels];
+
+        u64 hits = 0;
+        u64 builds = 0;
+        u64 evictions = 0;
+        u64 overflows = 0;
+
+        Entry* __acquire(RenderCommandBuffer& commands, Structs::ChunkPos position);
+    public:
+        /**
+         * @brief Constructs an empty overview.
+         *
+         * @param capacity maximum number of cached regions,
+         * each takes `regionPixels * regionPixels * 4` bytes
+         */
+        explicit WorldOverview(const u32 capacity) : entries(capacity), index(capacity), capacity(capacity) {
+            //entries are never moved and the index never grows later
+            this->index.reserve(capacity);
+        }
+
+        ~WorldOverview() { this->clear(); }
+
+        WorldOverview(const WorldOverview&) = delete;
+        WorldOverview& operator=(const WorldOverview&) = delete;
+
+        /**
+         * @brief Starts a new frame. Has to be called before
+         * requesting textures for the frame.
+         */
+        void beginFrame() { this->currentFrame++; }
+
+        /**
+         * @brief Get the image of a region, generating it first
+         * if it's not cached or any of its chunks changed since.
+         *
+         * The image is `regionPixels` wide and tall, its top row is
+         * the region's top (highest Y) row of blocks. Blocks in chunks
+         * that don't exist and blocks without a texture are transparent.
+         *
+         * @param commands buffer of the frame, replaced textures are destroyed through it
+         * @param world the world
+         * @param region position of the region, in regions
+         * @param colors mip chain of block textures, holding their average colors
+         * @param numberOfChunks set to the number of existing chunks in the region if not nullptr
+         * @return SDL_Texture* or nullptr if the region has no chunks,
+         * the cache is full of regions used in this frame or
+         * the texture could not be created
+         */
+        SDL_Texture* get(
+            RenderCommandBuffer& commands, const World& world, Structs::ChunkPos region,
+            const TextureMipChain& colors, u32* numberOfChunks = nullptr
+        );
+
+        /**
+         * @brief Destroys every cached texture right away.
+         * No submitted frame may still be using them.
+         */
+        void clear();
+
+        /**
+         * @brief Get the position of the region containing a chunk.
+         */
+        static constexpr Structs::ChunkPos getRegionOf(const Structs::ChunkPos chunk) {
+            //rounds towards negative infinity, see `World::getChunkPosOf()`
+            return {chunk.x >> 3, chunk.y >> 3};
+        }
+
+        /**
+         * @brief Get statistics of the overview.
+         */
+        WorldOverviewStats getStats() const {
+            return {
+                this->entries.size(), this->capacity,
+                this->hits, this->builds, this->evictions, this->overflows
+            };
+        }
+};
\ No newline at end of file
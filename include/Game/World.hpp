@@ -2,41 +2,162 @@
 
 #include "Bindings.h"
 
+#include <algorithm>
 #include <cstdlib>
-#include <unordered_map>
 
 #include "deus.hpp"
+#include "DSA/ChunkMap.hpp"
+#include "DSA/ObjectPool.hpp"
 #include "Game/Block/Block.hpp"
 #include "Game/Block/Blocks.hpp"
+#include "Game/Chunk.hpp"
 #include "Game/Main/GameObject.hpp"
 #include "program.hpp"
 
+/**
+ * @brief Statistics of the world's chunk index,
+ * used to verify that lookups don't grow it.
+ */
 typedef struct {
-    u32 blockIDs[16][16];
-} Chunk;
-
-class PointHash {
-    public: size_t operator()(const Structs::ChunkPos& p) const { return p.x * p.x + p.y * p.y; }
-};
+    //Number of chunks stored
+    u64 chunks;
+    //Number of slots in the index
+    u64 slots;
+    //How many times the index had to grow
+    u64 growths;
+    //Number of read-only chunk lookups
+    u64 lookups;
+    //Number of read-only chunk lookups that found nothing
+    u64 misses;
+} ChunkIndexStats;
 
 class World : public GameObject {
+    public:
+        //Bytes of chunks in every page of the chunk pool
+        static constexpr size_t chunkPoolPageSize = 16 * 1024;
     protected:
-        std::unordered_map<Structs::ChunkPos, Chunk*, PointHash> chunks;
+        //Chunks are allocated from here instead of the heap,
+        //must be declared before the index so it outlives it
+        ObjectPool<Chunk, chunkPoolPageSize / sizeof(Chunk)> chunkPool;
+        ChunkMap<Chunk> chunks;
+
+        //Bumped whenever a chunk is unloaded, changes to chunks
+        //(including new ones) are tracked by their versions
+        u64 numberOfUnloads = 0;
+
+        //mutable since they're updated by const lookups
+        mutable u64 numberOfLookups = 0;
+        mutable u64 numberOfMisses = 0;
     public:
         explicit World(const u32 objectID) : GameObject(objectID), chunks(256) {}
         explicit World(const u32 objectID, const char* name) : GameObject(objectID, name), chunks(256) {}
         
         ~World() {
-            for(auto& [point, chunk] : this->chunks) {
-                free(chunk);
-            }
+            //chunks own their palettes, so they have to be destroyed
+            //one by one, but their memory is released by the pool at once
+            this->chunks.forEach([](Structs::ChunkPos, Chunk* chunk) {
+                chunk->~Chunk();
+            });
+        }
+
+        /**
+         * @brief Get position of the chunk containing the block at given position.
+         */
+        static constexpr Structs::ChunkPos getChunkPosOf(const i32 x, const i32 y) {
+            //arithmetic shift rounds towards negative infinity,
+            //which is exactly what's needed for negative coordinates
+            return {x >> 4, y >> 4};
+        }
+
+        /**
+         * @brief Get position of the block within its chunk.
+         */
+        static constexpr Structs::Point getPositionInChunk(const i32 x, const i32 y) {
+            return {x & (i32)(Chunk::size - 1), y & (i32)(Chunk::size - 1)};
+        }
+
+        /**
+         * @brief Get the chunk at given chunk position.
+         * 
+         * This is a read-only lookup - if there is no chunk,
+         * nothing is created and the chunk index is never modified,
+         * so it's safe to call for every empty position the camera sweeps over.
+         * 
+         * @param x horizontal chunk coordinate
+         * @param y vertical chunk coordinate
+         * @return const Chunk* or nullptr if there is no chunk
+         */
+        const Chunk* getChunk(const i32 x, const i32 y) const { return this->getChunk({x, y}); }
+        /**
+         * @brief Get the chunk at given chunk position.
+         * See `getChunk(x, y)`.
+         * 
+         * @param which chunk position
+         * @return const Chunk* or nullptr if there is no chunk
+         */
+        const Chunk* getChunk(const Structs::ChunkPos which) const {
+            const Chunk* chunk = this->chunks.find(which);
+            this->numberOfLookups++;
+            if(chunk == nullptr) this->numberOfMisses++;
+            return chunk;
         }
 
-        const Chunk* getChunk(const i32 x, const i32 y) { return this->chunks[{x, y}]; }
-        const Chunk* getChunk(const Structs::ChunkPos which) { return this->chunks[which]; }
+        /**
+         * @brief Get the chunk at given chunk position,
+         * creating it if it doesn't exist.
+         * 
+         * @param which chunk position
+         * @param blockID ID of the block a newly created chunk
+         * is filled with, unused if the chunk already exists
+         * @return Chunk* or nullptr if the chunk could not be created
+         */
+        Chunk* getOrCreateChunk(const Structs::ChunkPos which, const u32 blockID);
         
+        /**
+         * @brief Creates a chunk filled with a single block.
+         * 
+         * @param which chunk position
+         * @param blockID ID of the block to fill the chunk with
+         * @return `Enums::Status::SUCCESS` on success,
+         * 
+         * `Enums::Status::ALREADY_EXISTS` if the chunk already exists,
+         * 
+         * `Enums::Status::ALLOC_FAILURE` if it could not be allocated.
+         */
         Enums::Status populateChunk(const Structs::ChunkPos which, const u32 blockID);
 
+        /**
+         * @brief Removes the chunk at given position,
+         * its memory is reused by the next created chunk.
+         * 
+         * @param which chunk position
+         * @return `Enums::Status::SUCCESS` on success,
+         * 
+         * `Enums::Status::NONEXISTENT` if there is no chunk.
+         */
+        Enums::Status unloadChunk(const Structs::ChunkPos which);
+
+        /**
+         * @brief Get a number that changes whenever
+         * anything in the world changes.
+         */
+        u64 getVersion() const { return this->numberOfUnloads + Chunk::getNextVersion(); }
+
+        /**
+         * @brief Get allocation statistics of the chunk pool.
+         */
+        ObjectPoolStats getChunkPoolStats() const { return this->chunkPool.getStats(); }
+
+        /**
+         * @brief Get statistics of the chunk index.
+         */
+        ChunkIndexStats getChunkIndexStats() const {
+            return {
+                this->chunks.size(), this->chunks.capacity(), this->chunks.growths(),
+                this->numberOfLookups, this->numberOfMisses
+            };
+        }
+
         /**
          * @brief Get the Block at given position.
          * 
@@ -44,16 +165,92 @@ class World : public GameObject {
          * @param y 
          * @return const Block* or NULL if there is no block
          */
-        const Block* getBlockAt(i32 x, i32 y);
+        const Block* getBlockAt(i32 x, i32 y) const;
         /**
          * @brief Get the Block at given position.
          * 
          * @param pos block position
          * @return const Block* or NULL if there's no block
          */
-        const Block* getBlockAt(Structs::BlockPos pos) { return this->getBlockAt(pos.x, pos.y); }
+        const Block* getBlockAt(Structs::BlockPos pos) const { return this->getBlockAt(pos.x, pos.y); }
+
+        /**
+         * @brief Walks a rectangle of blocks chunk by chunk, calling
+         * `func(i32 x, i32 y, const u32* blockIDs, u32 count)` for every
+         * horizontal run of blocks belonging to the same chunk, where
+         * `blockIDs` are IDs of blocks from (x, y) to (x + count - 1, y).
+         * 
+         * Every chunk is looked up only once, instead of once per block,
+         * and runs in chunks that don't exist are skipped entirely.
+         * 
+         * Runs are handed out chunk by chunk: rows of chunks from the lowest,
+         * chunks of a row from left to right and, within a chunk, block rows
+         * from the lowest. Runs of the same block row are therefore only
+         * consecutive if the rectangle lies within a single column of chunks.
+         * 
+         * @param minX leftmost block column, inclusive
+         * @param minY lowest block row, inclusive
+         * @param maxX rightmost block column, inclusive
+         * @param maxY highest block row, inclusive
+         * @param func callback
+         */
+        template<typename F> void forEachBlockRow(
+            const i32 minX, const i32 minY, const i32 maxX, const i32 maxY, F func
+        ) const {
+            if(minX > maxX || minY > maxY) return;
+            const Structs::ChunkPos minChunk = getChunkPosOf(minX, minY);
+            const Structs::ChunkPos maxChunk = getChunkPosOf(maxX, maxY);
+            u32 blockIDs[Chunk::size];
+
+            for(i32 cy = minChunk.y; cy <= maxChunk.y; cy++) {
+                const i32 chunkY = cy * (i32)Chunk::size;
+                const i32 startY = std::max(minY, chunkY);
+                const i32 endY = std::min(maxY, chunkY + (i32)Chunk::size - 1);
+
+                for(i32 cx = minChunk.x; cx <= maxChunk.x; cx++) {
+                    const Chunk* chunk = this->getChunk(cx, cy);
+                    if(chunk == nullptr) continue;
+
+                    const i32 chunkX = cx * (i32)Chunk::size;
+                    const i32 startX = std::max(minX, chunkX);
+                    const u32 count = (u32)(std::min(maxX, chunkX + (i32)Chunk::size - 1) - startX + 1);
+
+                    for(i32 y = startY; y <= endY; y++) {
+                        chunk->getBlockIDs((u32)(startX - chunkX), (u32)(y - chunkY), count, blockIDs);
+                        func(startX, y, (const u32*)blockIDs, count);
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Sets the block at given position.
+         * 
+         * @param x 
+         * @param y 
+         * @param blockID ID of the block to place
+         * @return `Enums::Status::SUCCESS` on success,
+         * 
+         * `Enums::Status::NONEXISTENT` if there is no chunk at that position,
+         * 
+         * `Enums::Status::ALLOC_FAILURE` if the chunk could not be re-packed.
+         */
+        Enums::Status setBlockAt(i32 x, i32 y, u32 blockID);
+        /**
+         * @brief Sets the block at given position.
+         * 
+         * @param pos block position
+         * @param blockID ID of the block to place
+         * @return see `setBlockAt(x, y, blockID)`
+         */
+        Enums::Status setBlockAt(Structs::BlockPos pos, u32 blockID) { return this->setBlockAt(pos.x, pos.y, blockID); }
+
+        /**
+         * @brief Get number of bytes used by all chunks of the world.
+         */
+        size_t getChunkMemoryUsage() const;
 
-        void printChunk(i32 x, i32 y);
-        void printChunk(Structs::ChunkPos pos) { this->printChunk(pos.x, pos.y); }
+        void printChunk(i32 x, i32 y) const;
+        void printChunk(Structs::ChunkPos pos) const { this->printChunk(pos.x, pos.y); }
 
 };
\ No newline at end of file
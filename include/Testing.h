@@ -19,6 +19,31 @@ void __checkTestEq__(int v, const char isFatal, const char* failFmt, ...);
  */
 void __registerTestFunction__(fptr f);
 
+//Outputs a line of benchmark results in printf style
+//to the same output as failed tests.
+void __reportBench__(const char* fmt, ...);
+
+/**
+ * @brief Reports results of a benchmark, see `BENCH(name)`.
+ */
+#define BENCH_REPORT(fmt, ...) __reportBench__(fmt, ##__VA_ARGS__)
+
+#if defined(DO_TEST) && defined(DO_BENCH)
+/**
+ * @brief Generate a function that runs a benchmark.
+ * Like with `TEST(name)`, write it at the end of a source file.
+ * Benchmarks take far longer than tests, so they're only run
+ * by builds compiled for testing with DO_BENCH defined as well,
+ * otherwise the function is never called.
+ */
+#define BENCH(name) \
+void __bench__##name(); \
+BeforeMain(__register_bench__##name) { __registerTestFunction__(__bench__##name); } \
+void __bench__##name()
+#else
+#define BENCH(name) static inline void __bench__##name()
+#endif
+
 #ifdef DO_TEST
 /**
  * @brief Generate a function that runs tests.
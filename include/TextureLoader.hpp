@@ -0,0 +1,128 @@
+#pragma once
+
+#include "Bindings.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <SDL_surface.h>
+
+#include "deus.hpp"
+
+/**
+ * @brief An image decoded by a `TextureLoader`.
+ */
+struct TextureLoadResult {
+    //Handle of the texture the image was requested for
+    u32 handle = 0;
+    //Path the image was read from
+    std::string path;
+    //Decoded image, nullptr on failure, to be freed by whoever polled it
+    SDL_Surface* surface = nullptr;
+    Enums::Status status = Enums::Status::SUCCESS;
+    //Why decoding failed, if it did
+    std::string error;
+};
+
+/**
+ * @brief Statistics of asynchronous texture loading.
+ */
+typedef struct {
+    //Number of images requested
+    u64 requested;
+    //Number of images decoded
+    u64 decoded;
+    //Number of images that could not be decoded
+    u64 failed;
+    //Number of images queued or being decoded
+    u64 pending;
+    //Number of decoded images turned into textures
+    u64 uploaded;
+    //Ticks spent turning decoded images into textures during the latest frame
+    u64 uploadTime;
+} TextureLoaderStats;
+
+/**
+ * @brief A pool of worker threads reading and decoding images
+ * into surfaces, so that loading textures doesn't stall the main loop.
+ *
+ * Only decoding happens on the workers. Decoded surfaces are
+ * polled by the owner, which turns them into textures on
+ * the thread the rendering context is used from.
+ */
+class TextureLoader {
+    private:
+        struct Job {
+            u32 handle;
+            std::string path;
+        };
+
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        //Signaled when a job is queued or the workers should stop
+        std::condition_variable jobCondition;
+        std::deque<Job> jobs;
+        std::deque<TextureLoadResult> results;
+        bool stopping = false;
+
+        u64 requested = 0;
+        u64 decoded = 0;
+        u64 failed = 0;
+        //Jobs taken by workers and not finished yet
+        u64 inProgress = 0;
+
+        void __run();
+    public:
+        TextureLoader() = default;
+
+        ~TextureLoader() { this->stop(); }
+
+        TextureLoader(const TextureLoader&) = delete;
+        TextureLoader& operator=(const TextureLoader&) = delete;
+
+        /**
+         * @brief Starts the worker threads.
+         *
+         * @param numberOfWorkers number of threads, at least 1
+         * @return `Enums::Status::SUCCESS` on success,
+         *
+         * `Enums::Status::FAILURE` if no thread could be started.
+         */
+        Enums::Status start(u32 numberOfWorkers);
+
+        /**
+         * @brief Stops the worker threads, discarding queued jobs
+         * and freeing images nobody polled.
+         */
+        void stop();
+
+        bool isRunning() const { return !this->workers.empty(); }
+
+        /**
+         * @brief Queues an image to be decoded.
+         *
+         * @param handle handle of the texture the image is for
+         * @param path path to the image, copied
+         * @return `Enums::Status::SUCCESS` on success,
+         *
+         * `Enums::Status::ALLOC_FAILURE` if the job could not be queued.
+         */
+        Enums::Status request(u32 handle, const char* path);
+
+        /**
+         * @brief Takes the oldest decoded image, if there is one.
+         *
+         * @param result filled with the decoded image
+         * @return whether there was one
+         */
+        bool poll(TextureLoadResult& result);
+
+        /**
+         * @brief Get statistics of decoding, without the upload fields.
+         */
+        TextureLoaderStats getStats();
+};
\ No newline at end of file
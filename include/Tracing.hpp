@@ -0,0 +1,131 @@
+#ifndef TRACING_HPP
+/**
+ * @file Tracing.hpp
+ * @brief Recording of timed zones into per-thread buffers,
+ * exported as a Chrome trace (chrome://tracing, ui.perfetto.dev)
+ * for inspecting frame hitches offline.
+ * 
+ * Zones are only recorded when compiled with `TRACING` defined,
+ * otherwise the macros expand to nothing.
+ */
+#define TRACING_HPP
+
+#include "Bindings.h"
+
+#include <atomic>
+
+#include <SDL_thread.h>
+#include <SDL_timer.h>
+
+#include "deus.hpp"
+
+#ifdef TRACING
+#define __TraceConcat2(a, b) a##b
+#define __TraceConcat(a, b) __TraceConcat2(a, b)
+/**
+ * @brief Records a zone with the given name from here
+ * until the end of the enclosing scope.
+ * The name must outlive the trace, e.g. a string literal.
+ */
+#define TraceZone(name) TraceScope __TraceConcat(__traceZone, __LINE__)(name)
+/**
+ * @brief Records a zone named after the enclosing function
+ * until the end of the enclosing scope.
+ */
+#define TraceFunction() TraceScope __TraceConcat(__traceZone, __LINE__)(__func__)
+#else
+#define TraceZone(name)
+#define TraceFunction()
+#endif /* TRACING */
+
+/**
+ * @brief A zone recorded by a thread.
+ */
+typedef struct {
+    //Must outlive the trace
+    const char* name;
+    //Ticks of `SDL_GetPerformanceCounter()`
+    u64 begin;
+    u64 end;
+} TraceEvent;
+
+/**
+ * @brief Events recorded by a single thread, the most recent
+ * `capacity` of which are kept. Only the owning thread writes,
+ * the tracer may read concurrently.
+ */
+class TraceBuffer {
+    friend class Tracer;
+
+    public:
+        static constexpr u32 capacity = 1 << 16;
+    private:
+        //One more than the capacity, which is being written
+        //while the rest is read
+        static constexpr u32 numberOfSlots = capacity + 1;
+
+        //Fields are atomic only so that reading a slot while
+        //it's overwritten is defined; such reads are discarded
+        struct Slot {
+            std::atomic<const char*> name;
+            std::atomic<u64> begin;
+            std::atomic<u64> end;
+        };
+
+        SDL_threadID threadID;
+        Slot events[numberOfSlots];
+        //Number of events recorded so far
+        std::atomic<u64> numberOfEvents = 0;
+    public:
+        TraceBuffer(const SDL_threadID threadID) : threadID(threadID) {}
+
+        void record(const char* name, const u64 begin, const u64 end) {
+            const u64 n = this->numberOfEvents.load(std::memory_order_relaxed);
+            Slot& slot = this->events[n % numberOfSlots];
+            slot.name.store(name, std::memory_order_relaxed);
+            slot.begin.store(begin, std::memory_order_relaxed);
+            slot.end.store(end, std::memory_order_relaxed);
+            this->numberOfEvents.store(n + 1, std::memory_order_release);
+        }
+};
+
+class Tracer {
+    public:
+        /**
+         * @brief Get the calling thread's buffer,
+         * registering it on first use. Buffers outlive their threads.
+         */
+        static TraceBuffer& getThreadBuffer();
+
+        /**
+         * @brief Writes every recorded zone of every thread
+         * as a Chrome trace JSON file. Threads may keep recording meanwhile,
+         * zones they overwrite while it's written are left out.
+         * 
+         * @param path path of the file
+         * @return `Enums::Status::SUCCESS`, `Enums::Status::FAILURE`
+         * if the file could not be written or `Enums::Status::ALLOC_FAILURE`
+         */
+        static Enums::Status write(const char* path);
+};
+
+/**
+ * @brief Records a zone from its construction until its destruction.
+ * Use through `TraceZone(name)` and `TraceFunction()`.
+ */
+class TraceScope {
+    private:
+        const char* name;
+        u64 begin;
+    public:
+        TraceScope(const char* name) : name(name), begin(SDL_GetPerformanceCounter()) {}
+
+        ~TraceScope() {
+            Tracer::getThreadBuffer().record(this->name, this->begin, SDL_GetPerformanceCounter());
+        }
+
+        TraceScope(const TraceScope&) = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+};
+
+#endif /* TRACING_HPP */
\ No newline at end of file
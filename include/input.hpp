@@ -283,7 +283,21 @@ class InputHandler {
             return latestEvents.buffer[latestEvents.index];
         }
         
-        void processInput(Game& game);
+        /**
+         * @brief Handles every pending event.
+         * 
+         * @param game the game
+         * @param timeout milliseconds to block for while there are no events,
+         * 0 to return right away
+         */
+        void processInput(Game& game, u32 timeout = 0);
+
+        /**
+         * @brief Applies keys that act for as long as they're held,
+         * like moving the camera. Called once per simulation tick,
+         * so that their effect doesn't depend on the frame rate.
+         */
+        void processHeldKeys(Game& game);
 
         void checkForKeyCombination(u64 comb);
 
@@ -3,6 +3,7 @@
 #include "Bindings.h"
 
 #include <chrono>
+#include <mutex>
 #include <string>
 #include <thread>
 
@@ -26,6 +27,9 @@ struct alignas(8) ProgramFlags {
     u8 canPlaySound : 1 = false;
     u8 running : 1 = false;
     u8 paused : 1 = false;
+    u8 minimized : 1 = false;
+    u8 headless : 1 = false;
+    u8 renderThread : 1 = false;
 };
 
 typedef struct {
@@ -51,9 +55,35 @@ class Program {
          */
         NoDiscard Enums::Status initSystems();
 
+        /**
+         * @brief Makes `initSystems()` use SDL's dummy video and audio drivers
+         * and a software renderer drawing into an in-memory surface
+         * instead of a window, so that frames can be rendered
+         * without a display or a GPU (benchmarks, golden images on CI machines).
+         * Has to be called before `initSystems()`.
+         */
+        void setHeadless(const bool headless) { this->flags.headless = headless; }
+        bool isHeadless() const { return this->flags.headless; }
+
+        /**
+         * @brief Makes frames execute on a render thread where the backend
+         * allows it (see `RenderThread`). Off by default, as it hasn't been
+         * verified against the Direct3D backends yet.
+         * Has to be called before `initSystems()`.
+         */
+        void setRenderThreadEnabled(const bool enabled) { this->flags.renderThread = enabled; }
+        bool isRenderThreadEnabled() const { return this->flags.renderThread; }
+
         static u64 getClockFrequency() { return Program::clockFrequency; }
 
         static SDL_Renderer* getRenderingContext() { return Program::renderingContext; }
+        /**
+         * @brief Get the lock guarding the rendering context.
+         * SDL renderers are not thread-safe, so anything calling into
+         * the rendering context while frames may be submitted on the render
+         * thread (creating, modifying or destroying textures) has to hold it.
+         */
+        static std::recursive_mutex& getRenderingLock() { return Program::renderingLock; }
         static Logger& getLogger() { return Program::logger; }
         // static InputHandler& getInputHandler() { return inputHandler; }
         static ResourceManager& getResourceManager() { return Program::resourceManager; }
@@ -68,6 +98,14 @@ class Program {
          */
         SDL_Window* getWindow() { return this->window; }
 
+        /**
+         * @brief Get the surface frames are rendered into in headless mode.
+         * 
+         * @return SDL_Surface*, nullptr if not headless, this is a handle
+         * to internal resource, do not modify
+         */
+        SDL_Surface* getFrameSurface() { return this->frameSurface; }
+
         Structs::Color getBackgroundColor() const { return this->backgroundColor; }
         void setBackgroundColor(const Structs::Color color) { this->backgroundColor = color; }
         void setBackgroundColor(const u8 red, const u8 green, const u8 blue, const u8 alpha) { this->backgroundColor = {red, green, blue, alpha}; }
@@ -95,7 +133,10 @@ class Program {
         //Video-related members
         SDL_Window* window;
         WindowParameters windowParameters;
+        //Render target of the software renderer in headless mode
+        SDL_Surface* frameSurface = nullptr;
         static SDL_Renderer* renderingContext;
+        static std::recursive_mutex renderingLock;
         Structs::Color backgroundColor = Structs::Colors::BLACK;
         Structs::Point mousePosition;
         u32 mouseButtons = 0;
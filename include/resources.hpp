@@ -8,15 +8,20 @@
 #include <SDL_image.h>
 #include <SDL_mixer.h>
 #include <SDL_ttf.h>
+#include <functional>
+#include <list>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "deus.hpp"
+#include "TextureLoader.hpp"
 
 extern const char* emptyCString;
 extern const char* noErrorCString;
 
 class RenderableObject;
+class RenderCommandBuffer;
 
 //TODO: finish ResourceManager in terms of SFX, Music
 //and documentation
@@ -30,7 +35,7 @@ typedef uint32_t FontHandle;
  * @brief Flags for textures, loaded
  * from a file or created dynamically.
  * 
- * Flags 6-31 are reserved for internal use.
+ * Flags 7-31 are reserved for internal use.
  */
 typedef enum {
     //Causes the texture to be loaded immediately
@@ -51,16 +56,39 @@ typedef enum {
     TextureFlags_ScaleModeLinear = 1 << 4,
     //Anisotropic filtering
     TextureFlags_ScaleModeBest = 2 << 4,
+
+    //Keeps the texture loaded once it is, it's never unloaded
+    //to fit the texture memory budget or after its time runs out
+    TextureFlags_Pinned = 1 << 6,
+
+    //Internal flag to signal that the texture was unloaded by
+    //`ResourceManager::trimTextures()` and not loaded again yet.
+    TextureFlags_Evicted = 1 << 28,
+    //Internal flag to signal that the texture is being loaded asynchronously.
+    TextureFlags_Loading = 1 << 29,
+    //Internal flag to signal that loading the texture asynchronously failed,
+    //so that it isn't retried every time it's requested.
+    TextureFlags_LoadFailed = 1 << 30,
     //Internal flag to signal whether a handle is valid.
     TextureFlags_IsValid = 1 << 31
 } TextureFlags;
 
+/**
+ * @brief Called once a texture requested with
+ * `ResourceManager::loadTextureAsync(...)` is loaded or failed to.
+ */
+typedef std::function<void(TextureHandle, Enums::Status)> TextureLoadCallback;
+
 typedef struct TextureData {
     SDL_Texture* texture = nullptr;
     const char* location = nullptr;
     u32 flags = 0;
     u32 milisecondsToUnload = 0;
     u64 lastAccessedAt = 0;
+    //Known once it's first loaded and kept while it's unloaded
+    Structs::Size originalSize = {0, 0};
+    //What it takes in video memory while loaded, mipmaps and driver padding aside
+    u64 bytes = 0;
 } TextureData;
 
 /**
@@ -120,6 +148,40 @@ typedef struct FontData {
     u32 properties;
 } FontData;
 
+/**
+ * @brief Statistics of the text texture cache.
+ */
+typedef struct {
+    //Number of requests for a text already rasterized
+    u64 hits;
+    //Number of requests that had to rasterize the text
+    u64 misses;
+    //Number of cached textures no longer referenced that were destroyed
+    u64 evictions;
+    //Number of cached textures
+    u64 entries;
+    //Number of cached textures with no references, kept for reuse
+    u64 unreferenced;
+} TextTextureCacheStats;
+
+/**
+ * @brief Statistics of textures kept in memory.
+ */
+typedef struct {
+    //Number of loaded textures
+    u64 resident;
+    //Estimated bytes of loaded textures
+    u64 residentBytes;
+    //Bytes textures are kept under, 0 for no limit
+    u64 budget;
+    //Number of textures unloaded for not being used within their time
+    u64 expired;
+    //Number of textures unloaded to fit the budget
+    u64 evicted;
+    //Number of unloaded textures requested again
+    u64 reloaded;
+} TextureResidencyStats;
+
 class ResourceManager {
     friend class Program;
 
@@ -134,6 +196,62 @@ class ResourceManager {
         std::vector<Mix_Music*> music;
         std::vector<FontData> fonts;
 
+        //Everything a text texture is rasterized from
+        struct TextTextureKey {
+            //Text with its terminator, UTF-16 text is stored as raw bytes
+            std::string text;
+            FontHandle font;
+            Structs::Color color;
+            u32 wrapLength;
+            TextEncoding encoding;
+
+            bool operator==(const TextTextureKey& other) const;
+        };
+        struct TextTextureKeyHash {
+            size_t operator()(const TextTextureKey& key) const noexcept;
+        };
+        struct TextTextureEntry {
+            TextureHandle handle;
+            u32 references;
+            //Position in `unreferencedTextTextures` while it has no references
+            std::list<TextureHandle>::iterator unreferencedAt;
+        };
+        typedef std::unordered_map<TextTextureKey, TextTextureEntry, TextTextureKeyHash> TextTextureMap;
+        //Text textures shared by everyone requesting the same text
+        TextTextureMap textTextures;
+        //Keys of cached text textures, by their handles
+        std::unordered_map<TextureHandle, const TextTextureKey*> textTextureKeys;
+        //Handles of evicted text textures, reused for new ones
+        std::vector<TextureHandle> freeTextTextureHandles;
+        //Handles of cached text textures without references,
+        //the least recently released first
+        std::list<TextureHandle> unreferencedTextTextures;
+        u32 maxUnreferencedTextTextures = 128;
+        TextTextureCacheStats textTextureStats = {};
+
+        //Textures destroyed once frames in flight no longer use them
+        std::vector<SDL_Texture*> retiredTextures;
+
+        //Decodes images of textures loaded asynchronously
+        TextureLoader loader;
+        //Callbacks waiting for textures being loaded asynchronously
+        std::unordered_map<TextureHandle, std::vector<TextureLoadCallback>> textureLoadCallbacks;
+        bool asyncLoading = true;
+        u64 texturesUploaded = 0;
+        u64 textureUploadTime = 0;
+
+        struct EvictionCandidate {
+            u64 lastAccessedAt;
+            TextureHandle handle;
+            u64 bytes;
+        };
+        //Reused by every `trimTextures()`
+        std::vector<EvictionCandidate> evictionCandidates;
+        u64 textureMemoryBudget = 0;
+        //Textures accessed since then were drawn by the latest frame
+        u64 lastTrimAt = 0;
+        TextureResidencyStats residencyStats = {};
+
         Enums::Status latestStatus = Enums::Status::SUCCESS;
         const char* errorMessage = emptyCString;
 
@@ -156,7 +274,7 @@ class ResourceManager {
          */
         SDL_Texture* __createFallbackTexture() noexcept;
 
-        Enums::Status __registerTextureAt(TextureHandle handle, const char* path, const u32 flags) noexcept;
+        Enums::Status __registerTextureAt(TextureHandle handle, const char* path, const u32 flags, const u32 maxTimeLoaded) noexcept;
 
         TextureHandle __createTextTexture(
             const void* text, const u32 flags, const FontHandle font,
@@ -168,6 +286,23 @@ class ResourceManager {
             const void* text, const u32 flags, const FontHandle font,
             const Structs::Color foregroundColor, const u32 wrapLength, const TextEncoding encoding
         ) noexcept;
+
+        TextureHandle __acquireTextTexture(
+            const void* text, const FontHandle font,
+            const Structs::Color foregroundColor, const u32 wrapLength, const TextEncoding encoding
+        ) noexcept;
+
+        //Destroys an unreferenced text texture, false if there's no memory to retire it
+        bool __evictTextTexture(TextTextureMap::iterator it) noexcept;
+        void __evictTextTextures(u32 maxUnreferenced) noexcept;
+
+        //Calls and forgets the callbacks waiting for the texture to load
+        void __finishTextureLoad(TextureHandle handle, Enums::Status status) noexcept;
+
+        //Whether the texture can be unloaded and transparently loaded again
+        bool __isTextureEvictable(TextureHandle handle) noexcept;
+        //Unloads the texture once frames in flight no longer use it
+        bool __evictTexture(TextureHandle handle) noexcept;
     public:
         Enums::Status init() noexcept;
         void shutdown() noexcept;
@@ -191,8 +326,9 @@ class ResourceManager {
          * is not specified.
          * @param flags texture flags OR'ed together
          * @param maxTimeLoaded how long should the texture remain loaded
-         * in memory after being requested. After this time, the texture is unloaded
-         * and memory is freed. Setting it to 0 removes the timer.
+         * in memory after being requested, in miliseconds. After this time,
+         * the texture is unloaded by `ResourceManager::trimTextures()`
+         * and loaded again when next requested. Setting it to 0 removes the timer.
          * Again, if the texture is unloaded and the path was a string created
          * on the stack, only God knows what will happen. DO. NOT. DO. THAT!
          * @return a unique index into the texture registry or 0
@@ -207,7 +343,7 @@ class ResourceManager {
          * Texture at index 0 is always valid and used as a fallback
          * if loading the texture from `path` fails.
          */
-        TextureHandle registerTexture(const char* path, const u32 flags) noexcept;
+        TextureHandle registerTexture(const char* path, const u32 flags, const u32 maxTimeLoaded = 0) noexcept;
         
         /**
          * @brief Registers a texture in the resource manager's
@@ -218,14 +354,20 @@ class ResourceManager {
          * same restrictions apply as with
          * `ResourceManager::registerTexture(...)`.
          * @param flags texture flags OR'ed together
+         * @param maxTimeLoaded see `ResourceManager::registerTexture(...)`
          * @return Enums::Status 
          */
-        Enums::Status registerTextureAt(TextureHandle handle, const char* path, const u32 flags) noexcept {
-            return this->__registerTextureAt(handle, path, flags);
+        Enums::Status registerTextureAt(TextureHandle handle, const char* path, const u32 flags, const u32 maxTimeLoaded = 0) noexcept {
+            return this->__registerTextureAt(handle, path, flags, maxTimeLoaded);
         }
         
         /**
          * @brief Creates a renderable text box using a UTF-8 character set.
+         * The texture belongs to the caller alone, who may rasterize other
+         * text into it with `ResourceManager::createTextTextureAt(...)` or
+         * destroy it, so it's never shared. Text that doesn't change and may
+         * be shown several times should use
+         * `ResourceManager::acquireTextTexture(...)` instead.
          * 
          * @param text text to make into a texture
          * @param flags texture flags OR'ed together.
@@ -248,7 +390,9 @@ class ResourceManager {
         }
 
         /**
-         * @brief Creates a renderable text box using a UTF-16 character set.
+         * @brief Creates a renderable text box using a UTF-16 character set,
+         * see the UTF-8 overload for how it differs from
+         * `ResourceManager::acquireTextTexture(...)`.
          * 
          * @param text text to make into a texture
          * @param flags texture flags OR'ed together.
@@ -320,13 +464,84 @@ class ResourceManager {
             );
         }
         
+        /**
+         * @brief Get a shared text texture of a UTF-8 text box,
+         * rasterizing it only if the same text with the same font,
+         * color and wrap length isn't cached already.
+         * Every handle acquired has to be released with
+         * `ResourceManager::releaseTextTexture(...)` and must neither be
+         * destroyed nor rasterized into, as others may be drawing it.
+         * 
+         * @param text text to make into a texture, copied into the cache
+         * @param font handle to the font, obtained from
+         * `ResourceManager::loadFont(...)`.
+         * @param foregroundColor color for the foreground of the text box
+         * @param wrapLength width at which lines are wrapped, 0 for none
+         * @return a TextureHandle, shared with every other request
+         * for the same text, or the fallback handle 0 on failure
+         */
+        TextureHandle acquireTextTexture(
+            const char* text, const FontHandle font,
+            const Structs::Color foregroundColor, const u32 wrapLength
+        ) noexcept {
+            return this->__acquireTextTexture(text, font, foregroundColor, wrapLength, TextEncoding::UTF8);
+        }
+
+        /**
+         * @brief Get a shared text texture of a UTF-16 text box,
+         * see the UTF-8 overload for details.
+         */
+        TextureHandle acquireTextTexture(
+            const char16_t* text, const FontHandle font,
+            const Structs::Color foregroundColor, const u32 wrapLength
+        ) noexcept {
+            return this->__acquireTextTexture(text, font, foregroundColor, wrapLength, TextEncoding::UTF16);
+        }
+
+        /**
+         * @brief Releases a reference to a text texture obtained from
+         * `ResourceManager::acquireTextTexture(...)`.
+         * Once unreferenced, the texture stays cached for reuse until
+         * too many others are unreferenced, then the least recently
+         * released ones are evicted.
+         * 
+         * @param handle handle to the texture
+         * @return `Enums::Status::SUCCESS` on success,
+         * 
+         * `Enums::Status::INVALID_ARGS` if `handle` isn't a cached text texture
+         * or has no references left.
+         */
+        Enums::Status releaseTextTexture(TextureHandle handle) noexcept;
+
+        /**
+         * @brief Sets how many unreferenced text textures are kept for reuse,
+         * evicting the least recently released ones above it.
+         */
+        void setTextTextureCacheSize(u32 maxUnreferenced) noexcept;
+
+        TextTextureCacheStats getTextTextureCacheStats() const noexcept {
+            TextTextureCacheStats stats = this->textTextureStats;
+            stats.entries = this->textTextures.size();
+            stats.unreferenced = this->unreferencedTextTextures.size();
+            return stats;
+        }
+
+        /**
+         * @brief Destroys textures evicted from caches, in the given frame,
+         * after every frame submitted before it is done with them.
+         * 
+         * @param commands buffer of the frame being recorded
+         */
+        void destroyRetiredTextures(RenderCommandBuffer& commands) noexcept;
+
         /**
          * @brief Get a pointer to the texture with a given texture handle.
          * It is a handle to internal data, do NOT modify.
          * 
          * @param handle handle to the texture, obtained from
          * `ResourceManager::registerTexture(path)`.
-         * @return pointer to internal texture object
+         * @return pointer to internal texture object, or to the fallback
+         * texture while it's being loaded asynchronously (see `setAsyncLoading()`)
          * 
          * If you need to modify the texture, do NOT do it yourself,
          * it is dangerous, risks memory leaks and potentially crashes.
@@ -334,10 +549,13 @@ class ResourceManager {
          */
         SDL_Texture* getTexture(TextureHandle handle) noexcept;
         /**
-         * @brief Query the texture for its original size.
+         * @brief Get the original size of the texture, as it was when it was
+         * first loaded. Never loads it mid-frame: until it's loaded
+         * asynchronously, the size of the fallback texture is returned.
          * 
          * @param handle handle to the texture
-         * @return size of the texture
+         * @return size of the texture, of the fallback texture
+         * while it's loading or `{0, 0}` if it cannot be loaded
          */
         Structs::Size getTextureOriginalSize(TextureHandle handle) noexcept;
 
@@ -364,8 +582,61 @@ class ResourceManager {
          */
         Enums::Status loadTexture(TextureHandle handle) noexcept;
 
+        /**
+         * @brief Starts loading the texture of the given handle
+         * on a worker thread. The texture is created once decoded,
+         * by `ResourceManager::uploadLoadedTextures(...)`, and until then
+         * `ResourceManager::getTexture(...)` returns the fallback texture.
+         * 
+         * @param handle handle to the texture
+         * @param callback called on the main thread once the texture
+         * is loaded or failed to, immediately if it's already loaded
+         * @return `Enums::Status::SUCCESS` if the texture is loaded or being loaded,
+         * a variety of status codes on failure;
+         * call `getLatestError()` for more information.
+         */
+        Enums::Status loadTextureAsync(TextureHandle handle, TextureLoadCallback callback = nullptr) noexcept;
+
+        /**
+         * @brief Creates textures from images decoded since the last call,
+         * until `budget` runs out (at least one, if there are any),
+         * and calls the callbacks of the textures loaded.
+         * Has to be called regularly on the main thread, e.g. once every frame.
+         * 
+         * @param budget ticks of `SDL_GetPerformanceCounter()` to spend
+         * @return number of decoded images processed
+         */
+        u32 uploadLoadedTextures(u64 budget) noexcept;
+
+        /**
+         * @brief Whether the texture of the given handle
+         * is being loaded asynchronously.
+         */
+        bool isTextureLoading(TextureHandle handle) const noexcept {
+            return this->isTextureHandleValid(handle) && (this->textures[handle].flags & TextureFlags_Loading);
+        }
+
+        /**
+         * @brief Sets whether `ResourceManager::getTexture(...)` and
+         * `ResourceManager::loadTextureAsync(...)` load textures
+         * asynchronously, serving the fallback texture until they're loaded,
+         * or load them right away. Asynchronous by default, disabled
+         * in headless mode so that captured frames don't depend on timing.
+         */
+        void setAsyncLoading(const bool enabled) noexcept { this->asyncLoading = enabled; }
+        bool isAsyncLoading() const noexcept { return this->asyncLoading; }
+
+        TextureLoaderStats getTextureLoaderStats() noexcept {
+            TextureLoaderStats stats = this->loader.getStats();
+            stats.uploaded = this->texturesUploaded;
+            stats.uploadTime = this->textureUploadTime;
+            return stats;
+        }
+
         /**
          * @brief Unloads the texture of the given handle.
+         * Frames already submitted may still use it, so
+         * wait for them to finish first (see `RenderThread::wait()`).
          * 
          * @param handle handle to the texture
          * @return `Enums::Status::SUCCESS` on success,
@@ -377,6 +648,8 @@ class ResourceManager {
         /**
          * @brief Destroys a given texture, freeing
          * its handle for other textures and invalidating it.
+         * Same as with `unloadTexture()`, frames already
+         * submitted must not use it anymore.
          * 
          * @param handle handle to the texture
          * 
@@ -392,6 +665,61 @@ class ResourceManager {
          */
         bool isTextTexture(TextureHandle handle) noexcept;
 
+        /**
+         * @brief Sets how long the texture remains loaded after being
+         * requested, see `ResourceManager::registerTexture(...)`.
+         * 
+         * @param handle handle to the texture
+         * @param maxTimeLoaded time in miliseconds, 0 removes the timer
+         * @return `Enums::Status::SUCCESS` on success,
+         * 
+         * `Enums::Status::INVALID_ARGS` if `handle` is invalid.
+         */
+        Enums::Status setTextureUnloadTime(TextureHandle handle, u32 maxTimeLoaded) noexcept;
+
+        /**
+         * @brief Sets whether the texture is kept loaded once it is,
+         * see `TextureFlags_Pinned`.
+         * 
+         * @param handle handle to the texture
+         * @param pinned whether it's pinned
+         * @return `Enums::Status::SUCCESS` on success,
+         * 
+         * `Enums::Status::INVALID_ARGS` if `handle` is invalid.
+         */
+        Enums::Status setTexturePinned(TextureHandle handle, bool pinned) noexcept;
+
+        /**
+         * @brief Sets how many bytes loaded textures may take,
+         * enforced by `ResourceManager::trimTextures()`.
+         * 
+         * @param bytes estimated bytes of every loaded texture, 0 for no limit
+         */
+        void setTextureMemoryBudget(const u64 bytes) noexcept { this->textureMemoryBudget = bytes; }
+        u64 getTextureMemoryBudget() const noexcept { return this->textureMemoryBudget; }
+
+        /**
+         * @brief Unloads textures not requested within their time and,
+         * while loaded textures take more than the budget, the least
+         * recently requested ones. Textures requested since the previous
+         * call are kept, as are pinned ones, text textures and those
+         * that have no path to be loaded again from.
+         * 
+         * Unloaded textures are loaded again the next time they're requested,
+         * like textures that were never loaded. They're destroyed once frames
+         * in flight no longer use them, by `ResourceManager::destroyRetiredTextures(...)`.
+         * Has to be called on the main thread before recording a frame.
+         * 
+         * @return number of textures unloaded
+         */
+        u32 trimTextures() noexcept;
+
+        TextureResidencyStats getTextureResidencyStats() const noexcept {
+            TextureResidencyStats stats = this->residencyStats;
+            stats.budget = this->textureMemoryBudget;
+            return stats;
+        }
+
 
         /**
          * @brief Loads a sound effect from a given path at
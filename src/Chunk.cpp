@@ -0,0 +1,272 @@
+#include "Game/Chunk.hpp"
+#include "Testing.h"
+
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace Enums;
+
+u32 Chunk::nextVersion = 0;
+
+Status Chunk::__pack(const u32* ids) noexcept {
+    u32 palette[numberOfBlocks];
+    u32 numberOfIDs = 0;
+    for(u32 i = 0; i < numberOfBlocks; i++) {
+        u32 j = 0;
+        while(j < numberOfIDs && palette[j] != ids[i]) j++;
+        if(j == numberOfIDs) palette[numberOfIDs++] = ids[i];
+    }
+
+    if(numberOfIDs == 1) {
+        this->fill(palette[0]);
+        return Status::SUCCESS;
+    }
+
+    u8 bits = 1, shift = 0;
+    while(((u32)1 << bits) < numberOfIDs) { bits <<= 1; shift++; }
+
+    u32* newStorage = (u32*)calloc(((size_t)1 << bits) + (numberOfBlocks * bits) / 32, sizeof(u32));
+    if(newStorage == nullptr) return Status::ALLOC_FAILURE;
+
+    free(this->storage);
+    this->storage = newStorage;
+    this->bitsPerBlock = bits;
+    this->bitsPerBlockShift = shift;
+    this->paletteSize = (u16)numberOfIDs;
+    memcpy(this->__palette(), palette, numberOfIDs * sizeof(u32));
+
+    for(u32 i = 0; i < numberOfBlocks; i++) {
+        u32 j = 0;
+        while(palette[j] != ids[i]) j++;
+        this->__setIndex(i, j);
+    }
+
+    return Status::SUCCESS;
+}
+
+Status Chunk::setBlockID(const u32 x, const u32 y, const u32 blockID) noexcept {
+    const u32 i = y * size + x;
+    if(this->getBlockID(x, y) == blockID) return Status::SUCCESS;
+    
+    if(this->bitsPerBlock != 0) {
+        u32* palette = this->__palette();
+        for(u32 j = 0; j < this->paletteSize; j++) {
+            if(palette[j] == blockID) {
+                this->__setIndex(i, j);
+                this->__touch();
+                return Status::SUCCESS;
+            }
+        }
+        if(this->paletteSize < ((u32)1 << this->bitsPerBlock)) {
+            palette[this->paletteSize] = blockID;
+            this->__setIndex(i, this->paletteSize++);
+            this->__touch();
+            return Status::SUCCESS;
+        }
+    }
+
+    //The palette is full (or the chunk is uniform),
+    //so the chunk has to be re-packed.
+    //Unused entries are dropped by __pack, so
+    //the chunk only grows if it really has to.
+    u32 ids[numberOfBlocks];
+    for(u32 j = 0; j < numberOfBlocks; j++) {
+        ids[j] = this->getBlockID(j % size, j / size);
+    }
+    ids[i] = blockID;
+
+    Status s = this->__pack(ids);
+    if(s == Status::SUCCESS) this->__touch();
+    return s;
+}
+
+void Chunk::fill(const u32 blockID) noexcept {
+    free(this->storage);
+    this->storage = nullptr;
+    this->uniformID = blockID;
+    this->paletteSize = 0;
+    this->bitsPerBlock = 0;
+    this->bitsPerBlockShift = 0;
+    this->__touch();
+}
+
+Status Chunk::repack() noexcept {
+    if(this->bitsPerBlock == 0) return Status::SUCCESS;
+
+    u32 ids[numberOfBlocks];
+    for(u32 j = 0; j < numberOfBlocks; j++) {
+        ids[j] = this->getBlockID(j % size, j / size);
+    }
+
+    return this->__pack(ids);
+}
+
+
+
+//Smallest number of bits per block able to index `numberOfIDs` IDs
+static u32 bitsFor(const u32 numberOfIDs) {
+    if(numberOfIDs <= 1) return 0;
+    u32 bits = 1;
+    while(((u32)1 << bits) < numberOfIDs) bits <<= 1;
+    return bits;
+}
+
+TEST(Chunk) {
+    constexpr u32 size = Chunk::size, numberOfBlocks = Chunk::numberOfBlocks;
+    Chunk chunk(7);
+    EXPECT_EQ(chunk.isUniform(), true);
+    EXPECT_EQ(chunk.getBitsPerBlock(), 0);
+    EXPECT_EQ(chunk.getMemoryUsage(), sizeof(Chunk));
+    EXPECT_EQ(chunk.getBlockID(15, 15), 7);
+
+    //setting a block to what it already is changes nothing
+    u32 version = chunk.getVersion();
+    EXPECT_EQ(chunk.setBlockID(3, 4, 7), Status::SUCCESS);
+    EXPECT_EQ(chunk.getVersion(), version);
+
+    //every new ID grows the palette, through every width up to 8 bits
+    u32 lastBits = 0;
+    for(u32 i = 0; i < numberOfBlocks; i++) {
+        ASSERT_EQ(chunk.setBlockID(i % size, i / size, 100 + i), Status::SUCCESS);
+        EXPECT_NEQ(chunk.getVersion(), version);
+        version = chunk.getVersion();
+
+        //the last write drops 7 from the chunk, but not from the palette
+        const u32 numberOfIDs = i + 2;
+        EXPECT_EQ(chunk.getPaletteSize(), numberOfIDs > numberOfBlocks ? numberOfBlocks : numberOfIDs);
+        EXPECT_EQ(chunk.getBitsPerBlock(), bitsFor(chunk.getPaletteSize()));
+        if(chunk.getBitsPerBlock() != lastBits) {
+            //every block survives re-packing
+            for(u32 j = 0; j < numberOfBlocks; j++) {
+                ASSERT_EQ(chunk.getBlockID(j % size, j / size), j <= i ? 100 + j : 7);
+            }
+            lastBits = chunk.getBitsPerBlock();
+        }
+    }
+    EXPECT_EQ(lastBits, 8);
+    EXPECT_EQ(chunk.getMemoryUsage(), sizeof(Chunk) + sizeof(u32) * (256 + 256 * 8 / 32));
+
+    u32 row[size];
+    chunk.getBlockIDs(5, 9, 11, row);
+    for(u32 x = 0; x < 11; x++) EXPECT_EQ(row[x], 100 + 9 * size + 5 + x);
+
+    //shrinking needs a repack, which drops unused entries
+    for(u32 i = 0; i < numberOfBlocks; i++) {
+        ASSERT_EQ(chunk.setBlockID(i % size, i / size, i % 3), Status::SUCCESS);
+    }
+    EXPECT_EQ(chunk.getBitsPerBlock(), 8);
+    EXPECT_EQ(chunk.repack(), Status::SUCCESS);
+    EXPECT_EQ(chunk.getBitsPerBlock(), 2);
+    EXPECT_EQ(chunk.getPaletteSize(), 3);
+    for(u32 i = 0; i < numberOfBlocks; i++) {
+        EXPECT_EQ(chunk.getBlockID(i % size, i / size), i % 3);
+    }
+
+    //a full palette drops unused entries instead of growing
+    for(u32 i = 0; i < numberOfBlocks; i++) {
+        ASSERT_EQ(chunk.setBlockID(i % size, i / size, i % 2), Status::SUCCESS);
+    }
+    EXPECT_EQ(chunk.setBlockID(0, 0, 20), Status::SUCCESS);
+    EXPECT_EQ(chunk.getPaletteSize(), 4);
+    EXPECT_EQ(chunk.setBlockID(1, 0, 21), Status::SUCCESS);
+    EXPECT_EQ(chunk.getBitsPerBlock(), 2);
+    EXPECT_EQ(chunk.getPaletteSize(), 4);
+    EXPECT_EQ(chunk.getBlockID(0, 0), 20);
+    EXPECT_EQ(chunk.getBlockID(1, 0), 21);
+    EXPECT_EQ(chunk.getBlockID(2, 0), 0);
+    EXPECT_EQ(chunk.getBlockID(3, 0), 1);
+
+    for(u32 i = 0; i < numberOfBlocks; i++) {
+        ASSERT_EQ(chunk.setBlockID(i % size, i / size, 42), Status::SUCCESS);
+    }
+    EXPECT_EQ(chunk.repack(), Status::SUCCESS);
+    EXPECT_EQ(chunk.isUniform(), true);
+    EXPECT_EQ(chunk.getBlockID(8, 8), 42);
+    EXPECT_EQ(chunk.getMemoryUsage(), sizeof(Chunk));
+
+    chunk.fill(3);
+    EXPECT_EQ(chunk.isUniform(), true);
+    EXPECT_EQ(chunk.getBlockID(0, 15), 3);
+}
+
+BENCH(Chunk) {
+    constexpr u32 size = Chunk::size, numberOfBlocks = Chunk::numberOfBlocks;
+    constexpr u32 numberOfChunks = 4096, rounds = 8;
+    //the layout chunks had before palettes
+    struct RawChunk { u32 ids[size][size]; };
+    struct Timer {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        double nanoseconds(const double operations) {
+            const auto now = std::chrono::steady_clock::now();
+            const double ns = std::chrono::duration<double, std::nano>(now - start).count() / operations;
+            start = now;
+            return ns;
+        }
+    };
+    volatile u32 sink = 0;
+    constexpr double operations = (double)rounds * numberOfChunks * numberOfBlocks;
+
+    BENCH_REPORT("Chunk vs u32[16][16] (raw), ns per block read/written:");
+    for(const u32 distinct : {1u, 2u, 4u, 16u, 256u}) {
+        std::vector<std::unique_ptr<Chunk>> chunks;
+        std::vector<RawChunk> raw(numberOfChunks);
+        for(u32 c = 0; c < numberOfChunks; c++) {
+            chunks.push_back(std::make_unique<Chunk>(0));
+            for(u32 i = 0; i < numberOfBlocks; i++) {
+                const u32 id = (i * 7 + c) % distinct;
+                chunks.back()->setBlockID(i % size, i / size, id);
+                raw[c].ids[i / size][i % size] = id;
+            }
+        }
+
+        u32 sum = 0;
+        Timer timer;
+        for(u32 r = 0; r < rounds; r++) for(const auto& chunk : chunks) {
+            for(u32 y = 0; y < size; y++) for(u32 x = 0; x < size; x++) sum += chunk->getBlockID(x, y);
+        }
+        const double get = timer.nanoseconds(operations);
+        for(u32 r = 0; r < rounds; r++) for(const RawChunk& chunk : raw) {
+            for(u32 y = 0; y < size; y++) for(u32 x = 0; x < size; x++) sum += chunk.ids[y][x];
+        }
+        const double rawGet = timer.nanoseconds(operations);
+
+        //only IDs already in the palette are written
+        u32 random = 1;
+        for(u32 r = 0; r < rounds; r++) for(const auto& chunk : chunks) {
+            for(u32 i = 0; i < numberOfBlocks; i++) {
+                random = random * 1664525 + 1013904223;
+                chunk->setBlockID(i % size, i / size, (random >> 16) % distinct);
+            }
+        }
+        const double set = timer.nanoseconds(operations);
+        random = 1;
+        for(u32 r = 0; r < rounds; r++) for(RawChunk& chunk : raw) {
+            for(u32 i = 0; i < numberOfBlocks; i++) {
+                random = random * 1664525 + 1013904223;
+                chunk.ids[i / size][i % size] = (random >> 16) % distinct;
+            }
+        }
+        const double rawSet = timer.nanoseconds(operations);
+        for(const RawChunk& chunk : raw) sum += chunk.ids[3][3];
+        sink = sink + sum;
+
+        BENCH_REPORT(
+            "%u bits, %3u IDs, %4zu B: get %6.2f (raw %.2f), set %6.2f (raw %.2f)",
+            chunks[0]->getBitsPerBlock(), distinct, chunks[0]->getMemoryUsage(),
+            get, rawGet, set, rawSet
+        );
+
+        if(distinct == 1) {
+            //the worst case, every write re-packs a uniform chunk to 1 bit
+            timer.nanoseconds(1);
+            for(const auto& chunk : chunks) {
+                chunk->fill(0);
+                chunk->setBlockID(5, 5, 1);
+            }
+            BENCH_REPORT("re-packing write: %.0f ns", timer.nanoseconds(numberOfChunks * 2.0));
+            EXPECT_EQ(chunks[0]->getBitsPerBlock(), 1);
+        }
+    }
+}
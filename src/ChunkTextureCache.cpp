@@ -0,0 +1,198 @@
+#include "Game/Render/ChunkTextureCache.hpp"
+#include "Game/Block/Blocks.hpp"
+
+#include <algorithm>
+
+using namespace Structs;
+
+void ChunkTextureCache::beginFrame(RenderCommandBuffer& commands, u32 pixelsPerBlock, ChunkPos cameraChunk) {
+    this->currentFrame++;
+    this->cameraChunk = cameraChunk;
+
+    u32 resolution = (u32)roundUpToPowerOf2(std::max(pixelsPerBlock, 1u));
+    if(resolution > maxPixelsPerBlock) resolution = maxPixelsPerBlock;
+    if(resolution == this->pixelsPerBlock) return;
+
+    //textures of a different size can't be reused,
+    //though they may still be drawn by frames in flight
+    this->__destroyTextures(&commands);
+    this->pixelsPerBlock = resolution;
+
+    const size_t side = (size_t)Chunk::size * resolution;
+    const u32 newCapacity = (u32)std::min<size_t>(this->memoryBudget / (side * side * 4), 65'536);
+
+    Entry* newEntries = (Entry*)realloc(this->entries, newCapacity * sizeof(Entry));
+    if(newEntries == nullptr && newCapacity != 0) {
+        this->capacity = 0;
+        return;
+    }
+    this->entries = newEntries;
+    u32* newOrder = (u32*)realloc(this->evictionOrder, newCapacity * sizeof(u32));
+    if(newOrder == nullptr && newCapacity != 0) {
+        this->capacity = 0;
+        return;
+    }
+    this->evictionOrder = newOrder;
+    this->capacity = newCapacity;
+
+    //the index never holds more entries than there are textures,
+    //so it won't have to grow (and throw) later
+    try {
+        this->index.reserve(this->capacity);
+    }
+    catch(const std::bad_alloc&) {
+        this->capacity = 0;
+    }
+}
+
+SDL_Texture* ChunkTextureCache::get(RenderCommandBuffer& commands, ChunkPos position, const Chunk& chunk) {
+    Entry* entry = this->index.find(position);
+    if(entry != nullptr) {
+        entry->lastUsedAt = this->currentFrame;
+        if(entry->chunk == &chunk && entry->version == chunk.getVersion()) {
+            this->hits++;
+            return entry->texture;
+        }
+        this->__render(commands, *entry, chunk);
+        return entry->texture;
+    }
+
+    entry = this->__acquire(commands, position);
+    if(entry == nullptr) {
+        this->overflows++;
+        return nullptr;
+    }
+    this->index.insert(position, entry);
+    entry->lastUsedAt = this->currentFrame;
+    this->__render(commands, *entry, chunk);
+    return entry->texture;
+}
+
+void ChunkTextureCache::clear() {
+    this->__destroyTextures(nullptr);
+}
+
+void ChunkTextureCache::__destroyTextures(RenderCommandBuffer* commands) {
+    for(u32 i = 0; i < this->numberOfEntries; i++) {
+        if(commands != nullptr) commands->destroyTexture(this->entries[i].texture);
+        else SDL_DestroyTexture(this->entries[i].texture);
+    }
+    this->numberOfEntries = 0;
+    this->numberOfEvictionCandidates = 0;
+    this->evictionOrderFrame = 0;
+    this->index.clear();
+}
+
+ChunkTextureCache::~ChunkTextureCache() {
+    this->clear();
+    free(this->entries);
+    free(this->evictionOrder);
+}
+
+ChunkTextureCache::Entry* ChunkTextureCache::__acquire(RenderCommandBuffer& commands, ChunkPos position) {
+    Entry* entry = nullptr;
+    if(this->numberOfEntries < this->capacity) {
+        const int side = (int)(Chunk::size * this->pixelsPerBlock);
+        SDL_Texture* texture = commands.createTexture(
+            SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, side, side
+        );
+        if(texture != nullptr) {
+            commands.setTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+            entry = &this->entries[this->numberOfEntries++];
+            entry->texture = texture;
+        }
+    }
+
+    if(entry == nullptr) {
+        if(this->evictionOrderFrame != this->currentFrame) this->__orderForEviction();
+        //entries requested since the order was made are skipped
+        while(this->numberOfEvictionCandidates > 0) {
+            Entry& candidate = this->entries[this->evictionOrder[--this->numberOfEvictionCandidates]];
+            if(candidate.lastUsedAt != this->currentFrame) {
+                entry = &candidate;
+                break;
+            }
+        }
+        if(entry == nullptr) return nullptr;
+
+        this->index.erase(entry->position);
+        this->evictions++;
+    }
+
+    entry->position = position;
+    entry->chunk = nullptr;
+    return entry;
+}
+
+void ChunkTextureCache::__orderForEviction() {
+    //The camera, and so distances, only change between frames,
+    //so entries are ordered at the first eviction of a frame
+    //instead of all being compared at every miss
+    this->evictionOrderFrame = this->currentFrame;
+    u32 n = 0;
+    for(u32 i = 0; i < this->numberOfEntries; i++) {
+        if(this->entries[i].lastUsedAt != this->currentFrame) this->evictionOrder[n++] = i;
+    }
+    this->numberOfEvictionCandidates = n;
+
+    auto distanceOf = [this](const Entry& entry) {
+        return (u64)std::max(
+            std::abs((i64)entry.position.x - this->cameraChunk.x),
+            std::abs((i64)entry.position.y - this->cameraChunk.y)
+        );
+    };
+    //the chunk furthest away from the camera goes last,
+    //the least recently used one if there are several
+    std::sort(this->evictionOrder, this->evictionOrder + n, [&](const u32 a, const u32 b) {
+        const u64 distanceA = distanceOf(this->entries[a]), distanceB = distanceOf(this->entries[b]);
+        if(distanceA != distanceB) return distanceA < distanceB;
+        return this->entries[a].lastUsedAt > this->entries[b].lastUsedAt;
+    });
+}
+
+void ChunkTextureCache::__render(RenderCommandBuffer& commands, Entry& entry, const Chunk& chunk) {
+    SDL_Texture* previousTarget = commands.getRenderTarget();
+    const SDL_Color previousColor = commands.getRenderDrawColor();
+    commands.setRenderTarget(entry.texture);
+    commands.setRenderDrawColor(0, 0, 0, 0);
+    commands.renderClear();
+
+    const int resolution = (int)this->pixelsPerBlock;
+    //blocks copied 1:1 from a downsampled level if there is one
+    const TextureAtlas* atlas = this->mips != nullptr ? this->mips->getLevel(this->pixelsPerBlock) : nullptr;
+    if(atlas == nullptr) atlas = this->atlas;
+    u32 blockIDs[Chunk::size];
+    u32 lastBlockID = (u32)-1;
+    SDL_Texture* lastTexture = nullptr;
+    const AtlasRegion* lastRegion = nullptr;
+    SDL_Rect r = {0, 0, resolution, resolution};
+    for(u32 y = 0; y < Chunk::size; y++) {
+        chunk.getBlockIDs(0, y, Chunk::size, blockIDs);
+        //the world's Y axis points up, the texture's points down
+        r.y = (int)(Chunk::size - 1 - y) * resolution;
+        r.x = 0;
+        for(u32 x = 0; x < Chunk::size; x++, r.x += resolution) {
+            if(blockIDs[x] != lastBlockID) {
+                lastBlockID = blockIDs[x];
+                lastRegion = atlas != nullptr ? atlas->getRegion(lastBlockID) : nullptr;
+                if(lastRegion != nullptr && lastRegion->page == nullptr) lastRegion = nullptr;
+                const Block* block = Blocks::getBlockWithID(lastBlockID);
+                lastTexture = block != nullptr ? block->getTexture() : nullptr;
+            }
+            if(lastRegion != nullptr) {
+                this->batch.addQuad(*lastRegion, {(float)r.x, (float)r.y, (float)r.w, (float)r.h});
+            }
+            else if(lastTexture != nullptr) {
+                commands.renderCopy(lastTexture, nullptr, &r);
+            }
+        }
+    }
+    if(atlas != nullptr) this->batch.flush(commands, *atlas);
+
+    commands.setRenderDrawColor(previousColor.r, previousColor.g, previousColor.b, previousColor.a);
+    commands.setRenderTarget(previousTarget);
+
+    entry.chunk = &chunk;
+    entry.version = chunk.getVersion();
+    this->renders++;
+}
\ No newline at end of file
@@ -1,5 +1,14 @@
 #include "DSA/BitArray.hpp"
+#include "DSA/ChunkMap.hpp"
 #include "DSA/ListArray.hpp"
+#include "Testing.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <unordered_map>
+#include <vector>
 
 
 BitArray::BitArray(const u64 initialSize) {
@@ -61,4 +70,115 @@ bool BitArray::reallocate(const u64 minimumNewSize) {
     this->numberOfBits = minimumNewSize;
     this->numberOfBitsAvailable = newSize * 8;
     return false;
-}
\ No newline at end of file
+}
+
+
+TEST(ChunkMap) {
+    //a small table, so that clusters wrap around its end
+    ChunkMap<u32> map(16);
+    u32 values[512];
+    Structs::ChunkPos positions[512];
+    for(u32 i = 0; i < 512; i++) {
+        values[i] = i;
+        positions[i] = {(i32)(i % 23) - 11, (i32)(i / 23) - 11};
+    }
+
+    for(u32 i = 0; i < 512; i++) {
+        EXPECT_EQ(map.insert(positions[i], &values[i]), Enums::Status::SUCCESS);
+    }
+    EXPECT_EQ(map.insert(positions[0], &values[1]), Enums::Status::ALREADY_EXISTS);
+    EXPECT_EQ(map.insert({1000, 1000}, nullptr), Enums::Status::NULL_PASSED);
+    EXPECT_EQ(map.find(positions[0]), &values[0]);
+    EXPECT_EQ(map.size(), 512);
+    //16 -> 1024 slots, at most 3/4 full
+    EXPECT_EQ(map.capacity(), 1024);
+    EXPECT_EQ(map.growths(), 6);
+
+    for(u32 i = 0; i < 512; i++) {
+        EXPECT_EQ(map.find(positions[i]), &values[i]);
+    }
+    EXPECT_EQ(map.find({12, 12}), nullptr);
+    EXPECT_EQ(map.erase({12, 12}), nullptr);
+
+    //erasing in a scattered order shifts entries back from every part
+    //of clusters, everything left has to stay reachable
+    bool erased[512] = {};
+    for(u32 n = 0; n < 512; n++) {
+        const u32 i = (n * 97) % 512;
+        ASSERT_EQ(map.erase(positions[i]), &values[i]);
+        erased[i] = true;
+        for(u32 j = 0; j < 512; j++) {
+            ASSERT_EQ(map.find(positions[j]), erased[j] ? nullptr : &values[j]);
+        }
+    }
+    EXPECT_EQ(map.size(), 0);
+    EXPECT_EQ(map.capacity(), 1024);
+    EXPECT_EQ(map.growths(), 6);
+
+    const Structs::ChunkPos extremes[] = {{INT32_MIN, INT32_MAX}, {INT32_MAX, INT32_MIN}, {-1, -1}, {0, 0}};
+    for(const Structs::ChunkPos pos : extremes) {
+        const Structs::ChunkPos unpacked = ChunkMap<u32>::unpack(ChunkMap<u32>::pack(pos));
+        EXPECT_EQ(unpacked.x, pos.x);
+        EXPECT_EQ(unpacked.y, pos.y);
+    }
+}
+
+BENCH(ChunkMap) {
+    //the hash World's chunk index used before ChunkMap
+    struct PointHash {
+        size_t operator()(const Structs::ChunkPos& p) const { return p.x * p.x + p.y * p.y; }
+    };
+    struct Timer {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        double nanoseconds(const size_t operations) {
+            const auto now = std::chrono::steady_clock::now();
+            const double ns = std::chrono::duration<double, std::nano>(now - start).count() / (double)operations;
+            start = now;
+            return ns;
+        }
+    };
+    static u32 value;
+
+    BENCH_REPORT("ChunkMap vs unordered_map, ns per insert/hit/miss/erase:");
+    for(const u32 n : {10'000u, 100'000u, 1'000'000u}) {
+        //a square of chunks around the origin, looked up in a shuffled order
+        const i32 side = (i32)ceil(sqrt((double)n));
+        std::vector<Structs::ChunkPos> positions, missing;
+        for(u32 i = 0; i < n; i++) {
+            positions.push_back({(i32)i % side - side / 2, (i32)i / side - side / 2});
+            missing.push_back({(i32)i % side - side / 2 + 3 * side, (i32)i / side - side / 2});
+        }
+        std::vector<Structs::ChunkPos> shuffled = positions;
+        std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(1));
+
+        u32 found = 0;
+        {
+            std::unordered_map<Structs::ChunkPos, u32*, PointHash> map;
+            Timer timer;
+            for(const Structs::ChunkPos pos : positions) map[pos] = &value;
+            const double insert = timer.nanoseconds(n);
+            for(const Structs::ChunkPos pos : shuffled) found += map.find(pos) != map.end();
+            const double hit = timer.nanoseconds(n);
+            for(const Structs::ChunkPos pos : missing) found += map.find(pos) != map.end();
+            const double miss = timer.nanoseconds(n);
+            for(const Structs::ChunkPos pos : shuffled) map.erase(pos);
+            const double erase = timer.nanoseconds(n);
+            BENCH_REPORT("%7u unordered_map %7.1f %7.1f %7.1f %7.1f", n, insert, hit, miss, erase);
+        }
+        {
+            //includes growing from 16 slots
+            ChunkMap<u32> map(16);
+            Timer timer;
+            for(const Structs::ChunkPos pos : positions) map.insert(pos, &value);
+            const double insert = timer.nanoseconds(n);
+            for(const Structs::ChunkPos pos : shuffled) found += map.find(pos) != nullptr;
+            const double hit = timer.nanoseconds(n);
+            for(const Structs::ChunkPos pos : missing) found += map.find(pos) != nullptr;
+            const double miss = timer.nanoseconds(n);
+            for(const Structs::ChunkPos pos : shuffled) map.erase(pos);
+            const double erase = timer.nanoseconds(n);
+            BENCH_REPORT("%7u ChunkMap      %7.1f %7.1f %7.1f %7.1f", n, insert, hit, miss, erase);
+        }
+        EXPECT_EQ(found, 2 * n);
+    }
+}
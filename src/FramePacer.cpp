@@ -0,0 +1,93 @@
+#include "Game/Main/FramePacer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#include <SDL_timer.h>
+
+void FramePacer::setFrameRate(const u32 frameRate) {
+    if(frameRate == this->frameRate) return;
+    this->frameRate = frameRate;
+    this->frameLength = frameRate > 0 ? this->clockFrequency / frameRate : 0;
+    this->nextFrameAt = 0;
+}
+
+void FramePacer::__sleepUntil(const u64 deadline) {
+    //spin for at least 0.25 ms and at most 4 ms
+    const u64 margin = std::clamp<u64>(
+        2 * this->sleepOvershoot, this->clockFrequency / 4000, this->clockFrequency / 250
+    );
+
+    u64 now = SDL_GetPerformanceCounter();
+    if(deadline > now + margin) {
+        const u64 ms = (deadline - now - margin) * 1000 / this->clockFrequency;
+        if(ms > 0) {
+            const u64 before = now;
+            sleep(ms);
+            now = SDL_GetPerformanceCounter();
+
+            const u64 requested = ms * this->clockFrequency / 1000;
+            const u64 overshoot = now - before > requested ? now - before - requested : 0;
+            this->sleepOvershoot = (this->sleepOvershoot * 7 + overshoot) / 8;
+        }
+    }
+
+    while(SDL_GetPerformanceCounter() < deadline) std::this_thread::yield();
+}
+
+void FramePacer::endFrame() {
+    u64 now = SDL_GetPerformanceCounter();
+
+    if(this->mode == FramePacingMode::SLEEP && this->frameLength > 0) {
+        if(this->nextFrameAt == 0) this->nextFrameAt = now;
+        else if(now < this->nextFrameAt) {
+            this->__sleepUntil(this->nextFrameAt);
+            now = SDL_GetPerformanceCounter();
+        }
+
+        this->nextFrameAt += this->frameLength;
+        //a whole frame behind - start over instead of rushing frames out
+        if(now >= this->nextFrameAt) this->nextFrameAt = now + this->frameLength;
+    }
+
+    if(this->lastFrameAt != 0) {
+        this->frameTimes[this->frameTimeIndex] = now - this->lastFrameAt;
+        this->frameTimeIndex = (this->frameTimeIndex + 1) % historySize;
+        if(this->numberOfFrameTimes < historySize) this->numberOfFrameTimes++;
+    }
+    this->lastFrameAt = now;
+}
+
+void FramePacer::reset() {
+    this->nextFrameAt = 0;
+    this->lastFrameAt = 0;
+    this->numberOfFrameTimes = 0;
+    this->frameTimeIndex = 0;
+}
+
+FramePacerStats FramePacer::getStats() const {
+    FramePacerStats stats = {this->numberOfFrameTimes, 0.0, 0.0, 0.0, 0.0};
+    const u32 n = this->numberOfFrameTimes;
+    if(n == 0) return stats;
+
+    const double toMs = 1000.0 / (double)this->clockFrequency;
+    double sorted[historySize];
+    double sum = 0.0;
+    for(u32 i = 0; i < n; i++) {
+        sorted[i] = (double)this->frameTimes[i] * toMs;
+        sum += sorted[i];
+    }
+    stats.mean = sum / n;
+
+    double variance = 0.0;
+    for(u32 i = 0; i < n; i++) {
+        variance += (sorted[i] - stats.mean) * (sorted[i] - stats.mean);
+    }
+    stats.stddev = sqrt(variance / n);
+
+    std::sort(sorted, sorted + n);
+    stats.p99 = sorted[(u32)ceil(0.99 * n) - 1];
+    stats.max = sorted[n - 1];
+    return stats;
+}
\ No newline at end of file
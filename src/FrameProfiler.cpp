@@ -0,0 +1,100 @@
+#include "Game/Main/FrameProfiler.hpp"
+#include "program.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+const char* FrameProfiler::getStageName(const FrameStage stage) {
+    switch(stage) {
+        case FrameStage::INPUT:      return "input";
+        case FrameStage::SIMULATION: return "simulation";
+        case FrameStage::WORLD:      return "world";
+        case FrameStage::UI:         return "UI";
+        case FrameStage::TEXT:       return "text";
+        case FrameStage::PRESENT:    return "present";
+    }
+    return "unknown";
+}
+
+void FrameProfiler::endFrame() {
+    //only this thread writes, so the counter can be read relaxed
+    const u64 n = this->numberOfFrames.load(std::memory_order_relaxed);
+    Slot& slot = this->frames[n % numberOfSlots];
+    for(u32 stage = 0; stage < numberOfFrameStages; stage++) {
+        slot.stageTimes[stage].store(this->current.stageTimes[stage], std::memory_order_relaxed);
+    }
+    //publishes the record to readers
+    this->numberOfFrames.store(n + 1, std::memory_order_release);
+}
+
+FrameProfilerStats FrameProfiler::getStats() const {
+    FrameProfilerStats stats = {};
+
+    static thread_local FrameRecord copy[numberOfSlots];
+    const u64 last = this->numberOfFrames.load(std::memory_order_acquire);
+    u64 first = last > historySize ? last - historySize : 0;
+    for(u64 i = first; i < last; i++) {
+        for(u32 stage = 0; stage < numberOfFrameStages; stage++) {
+            copy[i % numberOfSlots].stageTimes[stage] =
+                this->frames[i % numberOfSlots].stageTimes[stage].load(std::memory_order_relaxed);
+        }
+    }
+
+    //the writer may have overwritten the oldest records while they were copied,
+    //the one being written when copying ended included
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const u64 now = this->numberOfFrames.load(std::memory_order_relaxed);
+    if(now + 1 > first + numberOfSlots) first = std::min(now + 1 - numberOfSlots, last);
+
+    const u32 n = (u32)(last - first);
+    stats.frames = n;
+    if(n == 0) return stats;
+
+    const double toMs = 1000.0 / (double)this->clockFrequency;
+    double sorted[historySize];
+    for(u32 stage = 0; stage < numberOfFrameStages; stage++) {
+        for(u32 i = 0; i < n; i++) {
+            sorted[i] = (double)copy[(first + i) % numberOfSlots].stageTimes[stage] * toMs;
+        }
+        std::sort(sorted, sorted + n);
+        stats.stages[stage] = {
+            sorted[(u32)ceil(0.50 * n) - 1],
+            sorted[(u32)ceil(0.95 * n) - 1],
+            sorted[(u32)ceil(0.99 * n) - 1]
+        };
+    }
+    return stats;
+}
+
+size_t FrameProfiler::format(char* buffer, const size_t size) const {
+    if(size == 0) return 0;
+    const FrameProfilerStats stats = this->getStats();
+
+    size_t written = 0;
+    auto append = [&](int n) {
+        if(n > 0) written = std::min(written + (size_t)n, size - 1);
+    };
+    append(snprintf(
+        buffer, size, "%-10s %7s %7s %7s  (ms, %llu frames)",
+        "stage", "p50", "p95", "p99", (unsigned long long)stats.frames
+    ));
+    for(u32 stage = 0; stage < numberOfFrameStages; stage++) {
+        const FrameStageStats& s = stats.stages[stage];
+        append(snprintf(
+            buffer + written, size - written, "\n%-10s %7.3f %7.3f %7.3f",
+            getStageName((FrameStage)stage), s.p50, s.p95, s.p99
+        ));
+    }
+    return written;
+}
+
+void FrameProfiler::dump() const {
+    const FrameProfilerStats stats = this->getStats();
+    Logger& logger = Program::getLogger();
+    logger.info("Frame stage times of the last ", stats.frames, " frames (p50/p95/p99 in ms):");
+    for(u32 stage = 0; stage < numberOfFrameStages; stage++) {
+        const FrameStageStats& s = stats.stages[stage];
+        logger.info("  ", getStageName((FrameStage)stage), ": ", s.p50, " / ", s.p95, " / ", s.p99);
+    }
+}
\ No newline at end of file
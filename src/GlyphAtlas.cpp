@@ -0,0 +1,255 @@
+#include "Game/Render/GlyphAtlas.hpp"
+#include "program.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+using namespace Structs;
+
+bool GlyphAtlas::__addPage(RenderCommandBuffer& commands) {
+    //pages start out transparent, since static textures start out undefined
+    void* pixels = calloc((size_t)this->pageSize * this->pageSize, 4);
+    if(pixels == nullptr) return false;
+    SDL_Texture* page = commands.createTexture(
+        SDL_PIXELFORMAT_ARGB8888, (int)this->pageSize, (int)this->pageSize, pixels, (int)this->pageSize * 4
+    );
+    free(pixels);
+    if(page == nullptr) return false;
+
+    {
+        std::lock_guard<std::recursive_mutex> lock(Program::getRenderingLock());
+        SDL_SetTextureBlendMode(page, SDL_BLENDMODE_BLEND);
+    }
+    this->pages.append(page);
+    this->x = this->y = this->shelfHeight = 0;
+    return true;
+}
+
+bool GlyphAtlas::__rasterize(RenderCommandBuffer& commands, TTF_Font* ttf, const u32 codepoint, Glyph& glyph) {
+    glyph = {{nullptr, 0, {0.0f, 0.0f}, {0.0f, 0.0f}}, 0, 0, 0};
+
+    //glyphs the font doesn't have take no space
+    int minX, maxX, minY, maxY, advance;
+    if(TTF_GlyphMetrics32(ttf, codepoint, &minX, &maxX, &minY, &maxY, &advance) != 0) return true;
+    glyph.advance = advance;
+    //whitespace has nothing to draw
+    if(maxX <= minX || maxY <= minY) return true;
+
+    //rasterized in white, so that vertex colors can tint it
+    SDL_Surface* surface = TTF_RenderGlyph32_Blended(ttf, codepoint, {255, 255, 255, 255});
+    if(surface == nullptr) return false;
+    if(surface->format->format != SDL_PIXELFORMAT_ARGB8888) {
+        SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+        SDL_FreeSurface(surface);
+        if(converted == nullptr) return false;
+        surface = converted;
+    }
+
+    const u32 w = (u32)surface->w, h = (u32)surface->h;
+    if(w > this->pageSize || h > this->pageSize) {
+        SDL_FreeSurface(surface);
+        return true;
+    }
+
+    if(this->x + w > this->pageSize) {
+        this->x = 0;
+        this->y += this->shelfHeight + 1;
+        this->shelfHeight = 0;
+    }
+    if(this->pages.empty() || this->y + h > this->pageSize) {
+        if(!this->__addPage(commands)) {
+            SDL_FreeSurface(surface);
+            return false;
+        }
+    }
+
+    const u32 pageIndex = (u32)this->pages.size() - 1;
+    SDL_Texture* page = this->pages[pageIndex];
+    const SDL_Rect target = {(int)this->x, (int)this->y, (int)w, (int)h};
+    int status;
+    {
+        //frames in flight only draw from parts of the page written before
+        std::lock_guard<std::recursive_mutex> lock(Program::getRenderingLock());
+        status = SDL_UpdateTexture(page, &target, surface->pixels, surface->pitch);
+    }
+    SDL_FreeSurface(surface);
+    if(status != 0) return false;
+
+    const float inverseSize = 1.0f / (float)this->pageSize;
+    glyph.region = {
+        page, pageIndex,
+        {((float)this->x + 0.5f) * inverseSize, ((float)this->y + 0.5f) * inverseSize},
+        {((float)(this->x + w) - 0.5f) * inverseSize, ((float)(this->y + h) - 0.5f) * inverseSize}
+    };
+    glyph.width = (i32)w;
+    glyph.height = (i32)h;
+
+    this->x += w + 1;
+    this->shelfHeight = std::max(this->shelfHeight, h);
+    return true;
+}
+
+const Glyph* GlyphAtlas::getGlyph(RenderCommandBuffer& commands, const u32 codepoint) {
+    this->stats.lookups++;
+    if(codepoint < numberOfAsciiGlyphs) Likely {
+        if(this->asciiRasterized[codepoint]) Likely return &this->ascii[codepoint];
+    }
+    else {
+        const auto it = this->glyphs.find(codepoint);
+        if(it != this->glyphs.end()) return &it->second;
+    }
+
+    this->stats.misses++;
+    TTF_Font* ttf = Program::getResourceManager().getFont(this->font);
+    if(ttf == nullptr) return nullptr;
+
+    //failures aren't remembered, the glyph is tried again next time
+    Glyph glyph;
+    if(!this->__rasterize(commands, ttf, codepoint, glyph)) return nullptr;
+    this->stats.glyphs++;
+
+    if(codepoint < numberOfAsciiGlyphs) {
+        this->ascii[codepoint] = glyph;
+        this->asciiRasterized[codepoint] = true;
+        return &this->ascii[codepoint];
+    }
+    return &this->glyphs.emplace(codepoint, glyph).first->second;
+}
+
+i32 GlyphAtlas::getLineSkip() {
+    TTF_Font* ttf = Program::getResourceManager().getFont(this->font);
+    return ttf != nullptr ? TTF_FontLineSkip(ttf) : 0;
+}
+
+template<typename F>
+Size GlyphAtlas::__layout(
+    RenderCommandBuffer& commands, const char* text, const size_t length, const u32 wrapLength, F&& emit
+) {
+    TTF_Font* ttf = Program::getResourceManager().getFont(this->font);
+    if(ttf == nullptr || text == nullptr) return {0, 0};
+
+    const i32 lineSkip = TTF_FontLineSkip(ttf);
+    i32 penX = 0, penY = 0, width = 0;
+    u32 previous = 0;
+    const char* p = text;
+    while((size_t)(p - text) < length && *p != '\0') {
+        if(*p == '\n') {
+            width = std::max(width, penX);
+            penX = 0;
+            penY += lineSkip;
+            previous = 0;
+            p++;
+            continue;
+        }
+
+        //a word that doesn't fit anymore starts the next line
+        if(wrapLength > 0 && penX > 0 && *p != ' ' && p[-1] == ' ') {
+            i32 wordWidth = 0;
+            for(const char* q = p; (size_t)(q - text) < length && *q != '\0' && *q != ' ' && *q != '\n';) {
+                const Glyph* glyph = this->getGlyph(commands, GlyphAtlas::decodeUTF8(q));
+                if(glyph != nullptr) wordWidth += glyph->advance;
+            }
+            if(penX + wordWidth > (i32)wrapLength) {
+                width = std::max(width, penX);
+                penX = 0;
+                penY += lineSkip;
+                previous = 0;
+            }
+        }
+
+        const u32 codepoint = GlyphAtlas::decodeUTF8(p);
+        const Glyph* glyph = this->getGlyph(commands, codepoint);
+        if(glyph == nullptr) continue;
+        if(previous != 0) penX += TTF_GetFontKerningSizeGlyphs32(ttf, previous, codepoint);
+        if(glyph->region.page != nullptr) emit(*glyph, penX, penY);
+        penX += glyph->advance;
+        previous = codepoint;
+    }
+    width = std::max(width, penX);
+    return {(u32)width, (u32)(penY + TTF_FontHeight(ttf))};
+}
+
+Size GlyphAtlas::measure(RenderCommandBuffer& commands, const char* text, const u32 wrapLength) {
+    return this->__layout(commands, text, SIZE_MAX, wrapLength, [](const Glyph&, i32, i32) {});
+}
+
+Size GlyphAtlas::draw(
+    RenderCommandBuffer& commands, const char* text, const size_t length,
+    const SDL_FPoint position, const Color color, const u32 wrapLength
+) {
+    const SDL_Color vertexColor = {color.red, color.green, color.blue, color.alpha};
+    return this->__layout(commands, text, length, wrapLength, [&](const Glyph& glyph, const i32 x, const i32 y) {
+        const SDL_FRect target = {
+            position.x + (float)x, position.y + (float)y,
+            (float)glyph.width, (float)glyph.height
+        };
+        this->batch.addQuad(glyph.region, target, vertexColor);
+        this->stats.quads++;
+    });
+}
+
+void GlyphAtlas::clear() {
+    for(size_t i = 0; i < this->pages.size(); i++) {
+        SDL_DestroyTexture(this->pages[i]);
+    }
+    this->pages.clear();
+    this->glyphs.clear();
+    std::fill(this->asciiRasterized, this->asciiRasterized + numberOfAsciiGlyphs, false);
+    this->x = this->y = this->shelfHeight = 0;
+    this->stats.glyphs = 0;
+}
+
+GlyphAtlas* TextRenderer::getAtlas(const FontHandle font) {
+    if(font < this->atlases.size() && this->atlases[font] != nullptr) return this->atlases[font];
+    if(Program::getResourceManager().getFont(font) == nullptr) return nullptr;
+
+    while(this->atlases.size() <= font) this->atlases.append(nullptr);
+    this->atlases[font] = new(std::nothrow) GlyphAtlas(font, this->pageSize);
+    return this->atlases[font];
+}
+
+Size TextRenderer::measure(RenderCommandBuffer& commands, const FontHandle font, const char* text, const u32 wrapLength) {
+    GlyphAtlas* atlas = this->getAtlas(font);
+    if(atlas == nullptr) return {0, 0};
+    return atlas->measure(commands, text, wrapLength);
+}
+
+Size TextRenderer::draw(
+    RenderCommandBuffer& commands, const FontHandle font, const char* text,
+    const SDL_FPoint position, const Color color, const u32 wrapLength
+) {
+    GlyphAtlas* atlas = this->getAtlas(font);
+    if(atlas == nullptr) return {0, 0};
+    return atlas->draw(commands, text, position, color, wrapLength);
+}
+
+u32 TextRenderer::flush(RenderCommandBuffer& commands) {
+    u32 drawCalls = 0;
+    for(size_t i = 0; i < this->atlases.size(); i++) {
+        if(this->atlases[i] != nullptr) drawCalls += this->atlases[i]->flush(commands);
+    }
+    return drawCalls;
+}
+
+void TextRenderer::clear() {
+    for(size_t i = 0; i < this->atlases.size(); i++) {
+        delete this->atlases[i];
+    }
+    this->atlases.clear();
+}
+
+GlyphAtlasStats TextRenderer::getStats() const {
+    GlyphAtlasStats stats = {};
+    for(size_t i = 0; i < this->atlases.size(); i++) {
+        if(this->atlases[i] == nullptr) continue;
+        const GlyphAtlasStats s = this->atlases[i]->getStats();
+        stats.glyphs += s.glyphs;
+        stats.pages += s.pages;
+        stats.lookups += s.lookups;
+        stats.misses += s.misses;
+        stats.quads += s.quads;
+    }
+    return stats;
+}
\ No newline at end of file
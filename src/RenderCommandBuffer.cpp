@@ -0,0 +1,210 @@
+#include "Game/Render/RenderCommandBuffer.hpp"
+#include "program.hpp"
+
+void RenderCommandBuffer::begin(SDL_Renderer* renderer) {
+    this->commands.clear();
+    this->vertices.clear();
+    this->indices.clear();
+    this->renderer = renderer;
+    this->target = nullptr;
+    this->lastDrawnTexture = nullptr;
+    this->stats = {};
+}
+
+void RenderCommandBuffer::__countDraw(SDL_Texture* texture, const u64 numberOfVertices) {
+    this->stats.drawCalls++;
+    this->stats.vertices += numberOfVertices;
+    if(this->stats.drawCalls == 1 || texture != this->lastDrawnTexture) this->stats.textureSwitches++;
+    this->lastDrawnTexture = texture;
+}
+
+void RenderCommandBuffer::execute(SDL_Renderer* renderer) {
+    std::unique_lock<std::recursive_mutex> lock(Program::getRenderingLock());
+    const SDL_Vertex* v = this->vertices.data();
+    const int* i = this->indices.data();
+    for(size_t k = 0; k < this->commands.size(); k++) {
+        const RenderCommand& command = this->commands[k];
+        switch(command.type) {
+            case RenderCommandType::SET_TARGET:
+                SDL_SetRenderTarget(renderer, command.texture);
+                break;
+            case RenderCommandType::SET_DRAW_COLOR:
+                SDL_SetRenderDrawColor(
+                    renderer, command.color.r, command.color.g, command.color.b, command.color.a
+                );
+                break;
+            case RenderCommandType::CLEAR:
+                SDL_RenderClear(renderer);
+                break;
+            case RenderCommandType::COPY: {
+                const RenderCopyCommand& copy = command.copy;
+                const SDL_Rect* source = copy.hasSource ? &copy.source : nullptr;
+                const SDL_Rect* target = copy.hasTarget ? &copy.target : nullptr;
+                if(copy.angle == 0.0 && copy.flip == SDL_FLIP_NONE) {
+                    SDL_RenderCopy(renderer, command.texture, source, target);
+                }
+                else SDL_RenderCopyEx(renderer, command.texture, source, target, copy.angle, nullptr, copy.flip);
+                break;
+            }
+            case RenderCommandType::GEOMETRY: {
+                const RenderGeometryCommand& geometry = command.geometry;
+                SDL_RenderGeometry(
+                    renderer, command.texture,
+                    v + geometry.firstVertex, (int)geometry.numberOfVertices,
+                    geometry.numberOfIndices > 0 ? i + geometry.firstIndex : nullptr,
+                    (int)geometry.numberOfIndices
+                );
+                break;
+            }
+            case RenderCommandType::SET_TEXTURE_COLOR_MOD:
+                SDL_SetTextureColorMod(command.texture, command.color.r, command.color.g, command.color.b);
+                break;
+            case RenderCommandType::SET_TEXTURE_ALPHA_MOD:
+                SDL_SetTextureAlphaMod(command.texture, command.color.a);
+                break;
+            case RenderCommandType::SET_TEXTURE_BLEND_MODE:
+                SDL_SetTextureBlendMode(command.texture, command.blendMode);
+                break;
+            case RenderCommandType::DESTROY_TEXTURE:
+                SDL_DestroyTexture(command.texture);
+                break;
+            case RenderCommandType::PRESENT:
+                //everything queued is submitted under the lock, presenting then only
+                //waits for the swap chain, which nothing else has to wait for
+                SDL_RenderFlush(renderer);
+                lock.unlock();
+                SDL_RenderPresent(renderer);
+                lock.lock();
+                break;
+        }
+    }
+
+    this->commands.clear();
+    this->vertices.clear();
+    this->indices.clear();
+}
+
+SDL_Texture* RenderCommandBuffer::createTexture(const u32 format, const int access, const int width, const int height) {
+    std::lock_guard<std::recursive_mutex> lock(Program::getRenderingLock());
+    SDL_Texture* texture = SDL_CreateTexture(this->renderer, format, access, width, height);
+    if(texture != nullptr) this->stats.texturesCreated++;
+    return texture;
+}
+
+SDL_Texture* RenderCommandBuffer::createTexture(
+    const u32 format, const int width, const int height, const void* pixels, const int pitch
+) {
+    std::lock_guard<std::recursive_mutex> lock(Program::getRenderingLock());
+    SDL_Texture* texture = SDL_CreateTexture(this->renderer, format, SDL_TEXTUREACCESS_STATIC, width, height);
+    if(texture == nullptr) return nullptr;
+    //no frame can be using it yet
+    if(SDL_UpdateTexture(texture, nullptr, pixels, pitch) != 0) {
+        SDL_DestroyTexture(texture);
+        return nullptr;
+    }
+    this->stats.texturesCreated++;
+    return texture;
+}
+
+void RenderCommandBuffer::setRenderTarget(SDL_Texture* texture) {
+    RenderCommand& command = this->commands.emplaceBack();
+    command.type = RenderCommandType::SET_TARGET;
+    command.texture = texture;
+    this->target = texture;
+    this->stats.targetSwitches++;
+}
+
+void RenderCommandBuffer::setRenderDrawColor(const u8 red, const u8 green, const u8 blue, const u8 alpha) {
+    RenderCommand& command = this->commands.emplaceBack();
+    command.type = RenderCommandType::SET_DRAW_COLOR;
+    command.texture = nullptr;
+    command.color = {red, green, blue, alpha};
+    this->drawColor = command.color;
+    this->stats.drawColorChanges++;
+}
+
+void RenderCommandBuffer::renderClear() {
+    RenderCommand& command = this->commands.emplaceBack();
+    command.type = RenderCommandType::CLEAR;
+    command.texture = nullptr;
+}
+
+void RenderCommandBuffer::renderCopy(SDL_Texture* texture, const SDL_Rect* source, const SDL_Rect* target) {
+    this->renderCopyEx(texture, source, target, 0.0, SDL_FLIP_NONE);
+}
+
+void RenderCommandBuffer::renderCopyEx(
+    SDL_Texture* texture, const SDL_Rect* source, const SDL_Rect* target,
+    const double angle, const SDL_RendererFlip flip
+) {
+    RenderCommand& command = this->commands.emplaceBack();
+    command.type = RenderCommandType::COPY;
+    command.texture = texture;
+    command.copy.hasSource = source != nullptr;
+    command.copy.hasTarget = target != nullptr;
+    if(source != nullptr) command.copy.source = *source;
+    if(target != nullptr) command.copy.target = *target;
+    command.copy.angle = angle;
+    command.copy.flip = flip;
+    this->__countDraw(texture, 4);
+}
+
+void RenderCommandBuffer::renderGeometry(
+    SDL_Texture* texture,
+    const SDL_Vertex* vertices, const u32 numberOfVertices,
+    const int* indices, const u32 numberOfIndices
+) {
+    if(numberOfVertices == 0) return;
+
+    RenderCommand& command = this->commands.emplaceBack();
+    command.type = RenderCommandType::GEOMETRY;
+    command.texture = texture;
+    //offsets instead of pointers, since the arrays may still grow
+    command.geometry = {
+        (u32)this->vertices.size(), numberOfVertices,
+        (u32)this->indices.size(), indices != nullptr ? numberOfIndices : 0
+    };
+    this->__countDraw(texture, numberOfVertices);
+    for(u32 k = 0; k < numberOfVertices; k++) this->vertices.append(vertices[k]);
+    if(indices != nullptr) {
+        for(u32 k = 0; k < numberOfIndices; k++) this->indices.append(indices[k]);
+    }
+}
+
+void RenderCommandBuffer::setTextureColorMod(SDL_Texture* texture, const u8 red, const u8 green, const u8 blue) {
+    RenderCommand& command = this->commands.emplaceBack();
+    command.type = RenderCommandType::SET_TEXTURE_COLOR_MOD;
+    command.texture = texture;
+    command.color = {red, green, blue, 255};
+    this->stats.colorModChanges++;
+}
+
+void RenderCommandBuffer::setTextureAlphaMod(SDL_Texture* texture, const u8 alpha) {
+    RenderCommand& command = this->commands.emplaceBack();
+    command.type = RenderCommandType::SET_TEXTURE_ALPHA_MOD;
+    command.texture = texture;
+    command.color = {255, 255, 255, alpha};
+    this->stats.alphaChanges++;
+}
+
+void RenderCommandBuffer::setTextureBlendMode(SDL_Texture* texture, const SDL_BlendMode blendMode) {
+    RenderCommand& command = this->commands.emplaceBack();
+    command.type = RenderCommandType::SET_TEXTURE_BLEND_MODE;
+    command.texture = texture;
+    command.blendMode = blendMode;
+    this->stats.blendModeChanges++;
+}
+
+void RenderCommandBuffer::destroyTexture(SDL_Texture* texture) {
+    if(texture == nullptr) return;
+    RenderCommand& command = this->commands.emplaceBack();
+    command.type = RenderCommandType::DESTROY_TEXTURE;
+    command.texture = texture;
+    this->stats.texturesDestroyed++;
+}
+
+void RenderCommandBuffer::renderPresent() {
+    RenderCommand& command = this->commands.emplaceBack();
+    command.type = RenderCommandType::PRESENT;
+    command.texture = nullptr;
+}
\ No newline at end of file
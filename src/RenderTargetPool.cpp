@@ -0,0 +1,66 @@
+#include "Game/Render/RenderTargetPool.hpp"
+
+SDL_Texture* RenderTargetPool::acquire(
+    RenderCommandBuffer& commands, const int width, const int height,
+    const u32 format, const int access
+) {
+    for(size_t i = 0; i < this->entries.size(); i++) {
+        Entry& entry = this->entries[i];
+        if(entry.inUse) continue;
+        if(entry.width != width || entry.height != height) continue;
+        if(entry.format != format || entry.access != access) continue;
+
+        entry.inUse = true;
+        entry.lastUsedAt = this->currentFrame;
+        this->hits++;
+        return entry.texture;
+    }
+
+    this->misses++;
+    SDL_Texture* texture = commands.createTexture(format, access, width, height);
+    if(texture == nullptr) return nullptr;
+
+    this->entries.append({texture, width, height, format, access, true, this->currentFrame});
+    return texture;
+}
+
+void RenderTargetPool::release(SDL_Texture* texture) {
+    if(texture == nullptr) return;
+    for(size_t i = 0; i < this->entries.size(); i++) {
+        if(this->entries[i].texture == texture) {
+            this->entries[i].inUse = false;
+            return;
+        }
+    }
+}
+
+void RenderTargetPool::endFrame(RenderCommandBuffer& commands) {
+    this->currentFrame++;
+    for(size_t i = 0; i < this->entries.size();) {
+        Entry& entry = this->entries[i];
+        if(entry.inUse || this->currentFrame - entry.lastUsedAt <= this->evictAfterFrames) {
+            i++;
+            continue;
+        }
+        commands.destroyTexture(entry.texture);
+        //order doesn't matter, so the last entry takes its place
+        entry = this->entries[this->entries.size() - 1];
+        (void)this->entries.pop();
+        this->evictions++;
+    }
+}
+
+void RenderTargetPool::clear() {
+    for(size_t i = 0; i < this->entries.size(); i++) {
+        SDL_DestroyTexture(this->entries[i].texture);
+    }
+    this->entries.clear();
+}
+
+RenderTargetPoolStats RenderTargetPool::getStats() const {
+    u64 inUse = 0;
+    for(size_t i = 0; i < this->entries.size(); i++) {
+        if(this->entries[i].inUse) inUse++;
+    }
+    return {this->entries.size(), inUse, this->hits, this->misses, this->evictions};
+}
\ No newline at end of file
@@ -0,0 +1,124 @@
+#include "Game/Render/RenderThread.hpp"
+#include "program.hpp"
+#include "Tracing.hpp"
+
+#include <cstring>
+
+using namespace Enums;
+
+bool RenderThread::isSupportedBy(SDL_Renderer* renderer) {
+    SDL_RendererInfo info;
+    if(renderer == nullptr || SDL_GetRendererInfo(renderer, &info) != 0) return false;
+
+    //OpenGL contexts are bound to the thread that created them and
+    //the software renderer draws straight into the window's surface,
+    //which is recreated on the event thread whenever the window is resized.
+    //Direct3D devices can be used from any thread, as long as calls don't overlap,
+    //but presenting off the window's thread is unverified (see RenderThread)
+    static const char* supported[] = {"direct3d", "direct3d11", "direct3d12"};
+    for(const char* name : supported) {
+        if(strcmp(info.name, name) == 0) return true;
+    }
+    return false;
+}
+
+Status RenderThread::start(SDL_Renderer* renderer, const bool threaded) {
+    this->stop();
+    this->renderer = renderer;
+    this->stopping = false;
+    if(!threaded || !isSupportedBy(renderer)) return Status::SUCCESS;
+
+    try {
+        this->thread = std::thread(&RenderThread::__run, this);
+    }
+    catch(const std::system_error&) {
+        return Status::FAILURE;
+    }
+    this->threaded = true;
+    return Status::SUCCESS;
+}
+
+void RenderThread::stop() {
+    if(!this->threaded) return;
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopping = true;
+    }
+    this->submittedCondition.notify_one();
+    this->thread.join();
+    this->threaded = false;
+}
+
+RenderCommandBuffer& RenderThread::begin() {
+    RenderCommandBuffer& buffer = this->buffers[this->submitted % numberOfBuffers];
+    if(this->threaded) {
+        const u64 start = SDL_GetPerformanceCounter();
+        std::unique_lock<std::mutex> lock(this->mutex);
+        //the buffer is free once the frame recorded into it
+        //`numberOfBuffers` frames ago has been executed
+        this->executedCondition.wait(lock, [this]() {
+            return this->submitted - this->executed < numberOfBuffers;
+        });
+        this->waitTime = SDL_GetPerformanceCounter() - start;
+    }
+    buffer.begin(this->renderer);
+    return buffer;
+}
+
+void RenderThread::submit() {
+    RenderCommandBuffer& buffer = this->buffers[this->submitted % numberOfBuffers];
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->submitted++;
+    }
+    if(!this->threaded) this->__execute(buffer);
+    else this->submittedCondition.notify_one();
+}
+
+void RenderThread::wait() {
+    if(!this->threaded) return;
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->executedCondition.wait(lock, [this]() { return this->executed == this->submitted; });
+}
+
+RenderThreadStats RenderThread::getStats() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return {
+        this->submitted, this->executed,
+        this->executionTime, this->waitTime, this->commands,
+        this->threaded
+    };
+}
+
+void RenderThread::__execute(RenderCommandBuffer& buffer) {
+    const u64 start = SDL_GetPerformanceCounter();
+    const u64 numberOfCommands = buffer.size();
+    {
+        TraceZone("execute frame");
+        buffer.execute(this->renderer);
+    }
+    const u64 executionTime = SDL_GetPerformanceCounter() - start;
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->executionTime = executionTime;
+    this->commands = numberOfCommands;
+    this->executed++;
+}
+
+void RenderThread::__run() {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    while(true) {
+        this->submittedCondition.wait(lock, [this]() {
+            return this->stopping || this->executed < this->submitted;
+        });
+        //frames submitted before stopping are still executed,
+        //since they may destroy textures
+        if(this->executed == this->submitted) break;
+
+        RenderCommandBuffer& buffer = this->buffers[this->executed % numberOfBuffers];
+        lock.unlock();
+        this->__execute(buffer);
+        lock.lock();
+        this->executedCondition.notify_all();
+    }
+}
\ No newline at end of file
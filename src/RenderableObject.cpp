@@ -30,6 +30,8 @@ RenderableObjectBase::RenderableObjectBase(
     this->setVisible();
 }
 
+u64 RenderableObjectBase::version = 0;
+
 SDL_Texture* RenderableObjectBase::getTexture() const noexcept {
     return Program::getResourceManager().getTexture(this->textureHandle);
 }
@@ -41,6 +43,7 @@ RenderableObjectBase& RenderableObjectBase::bindTexture(
     this->textureHandle = textureHandle;
     this->setVisible();
 
+    this->__changed();
     return *this;
 }
 
@@ -71,6 +74,7 @@ RenderableObject::RenderableObject(
 RenderableObject& RenderableObject::setTexturePortion(const SDL_Rect& r) {
     this->texturePortion = r;
     
+    this->__changed();
     return *this;
 }
 
@@ -80,12 +84,14 @@ RenderableObject& RenderableObject::setTexturePortionOriginal() {
     this->texturePortion.w = (int)s.width;
     this->texturePortion.h = (int)s.height;
     
+    this->__changed();
     return *this;
 }
 
 RenderableObject& RenderableObject::setTargetPortion(const SDL_Rect& r) {
     this->targetPortion = r;
     
+    this->__changed();
     return *this;
 }
 
@@ -96,6 +102,7 @@ RenderableObject& RenderableObject::scaleX(const float scale) {
     this->targetPortion.w = (int)(scale * (float)Program::getResourceManager().getTextureOriginalSize(this->textureHandle).width);
     this->targetPortion.x -= (this->targetPortion.w - w) / 2;
 
+    this->__changed();
     return *this;
 }
 
@@ -106,6 +113,7 @@ RenderableObject& RenderableObject::scaleY(const float scale) {
     this->targetPortion.h = (int)(scale * (float)Program::getResourceManager().getTextureOriginalSize(this->textureHandle).height);
     this->targetPortion.y -= (this->targetPortion.h - h) / 2;
 
+    this->__changed();
     return *this;
 }
 
@@ -116,6 +124,7 @@ RenderableObject& RenderableObject::scale(const float scaleX, const float scaleY
     int w = this->targetPortion.w, h = this->targetPortion.h;
     this->targetPortion.w = (int)(scaleX * (float)originalSize.width);
     this->targetPortion.x -= (this->targetPortion.w - w) / 2;
+    this->__changed();
 
     if(scaleY < 0.0f) return *this;
     this->targetPortion.h = (int)(scaleY * (float)originalSize.height);
@@ -134,6 +143,7 @@ RenderableObject& RenderableObject::scale(const float scale) {
     this->targetPortion.x -= (this->targetPortion.w - w) / 2;
     this->targetPortion.y -= (this->targetPortion.h - h) / 2;
 
+    this->__changed();
     return *this;
 }
 
@@ -142,6 +152,7 @@ RenderableObject& RenderableObject::rotate(const double degrees) {
     while(this->angle >= 360.0) { this->angle -= 360.0; }
     while(this->angle <= 360.0) { this->angle += 360.0; }
     
+    this->__changed();
     return *this;
 }
 
@@ -149,6 +160,7 @@ RenderableObject& RenderableObject::setPositionOnScreen(const i32 x, const i32 y
     this->targetPortion.x = x;
     this->targetPortion.y = y;
 
+    this->__changed();
     return *this;
 }
 
@@ -156,6 +168,7 @@ RenderableObject& RenderableObject::setPositionOnScreenCentered(const i32 x, con
     this->targetPortion.x = x - this->targetPortion.w / 2;
     this->targetPortion.y = y - this->targetPortion.h / 2;
 
+    this->__changed();
     return *this;
 }
 
@@ -172,6 +185,7 @@ RenderableObject& RenderableObject::setSizeOnScreen(const u32 width, const u32 h
     this->targetPortion.w = (int)width;
     this->targetPortion.h = (int)height;
 
+    this->__changed();
     return *this;
 }
 
@@ -179,6 +193,7 @@ RenderableObject& RenderableObject::setSizeOnScreen(const Size size) {
     this->targetPortion.w = (int)size.width;
     this->targetPortion.h = (int)size.height;
 
+    this->__changed();
     return *this;
 }
 
@@ -186,6 +201,7 @@ RenderableObject& RenderableObject::moveOnScreen(const i32 dx, const i32 dy) {
     this->targetPortion.x += dx;
     this->targetPortion.y += dy;
 
+    this->__changed();
     return *this;
 }
 
@@ -193,6 +209,7 @@ RenderableObject& RenderableObject::stretchX(const float factor) {
     if(factor < 0.0) return *this;
     this->targetPortion.w = (int)roundf((float)this->targetPortion.w * factor);
 
+    this->__changed();
     return *this;
 }
 
@@ -200,12 +217,14 @@ RenderableObject& RenderableObject::stretchY(const float factor) {
     if(factor < 0.0) return *this;
     this->targetPortion.h = (int)roundf((float)this->targetPortion.h * factor);
 
+    this->__changed();
     return *this;
 }
 
 RenderableObject& RenderableObject::stretch(const float factorX, const float factorY) {
     if(factorX < 0.0) return *this;
     this->targetPortion.w = (int)roundf((float)this->targetPortion.w * factorX);
+    this->__changed();
     if(factorY < 0.0) return *this;
     this->targetPortion.h = (int)roundf((float)this->targetPortion.h * factorY);
 
@@ -218,6 +237,7 @@ RenderableObject& RenderableObject::stretch(const float factor) {
     this->targetPortion.w = (int)roundf((float)this->targetPortion.w * factor);
     this->targetPortion.h = (int)roundf((float)this->targetPortion.h * factor);
 
+    this->__changed();
     return *this;
 }
 
@@ -226,6 +246,7 @@ RenderableObject& RenderableObject::stretchX(const i32 dx) {
     this->targetPortion.w += dx;
     if(this->targetPortion.w < 0) this->targetPortion.w = 0;
 
+    this->__changed();
     return *this;
 }
 
@@ -233,6 +254,7 @@ RenderableObject& RenderableObject::stretchY(const i32 dy) {
     this->targetPortion.h += dy;
     if(this->targetPortion.h < 0) this->targetPortion.h = 0;
 
+    this->__changed();
     return *this;
 }
 
@@ -242,6 +264,7 @@ RenderableObject& RenderableObject::stretch(const i32 dx, const i32 dy) {
     if(this->targetPortion.w < 0) this->targetPortion.w = 0;
     if(this->targetPortion.h < 0) this->targetPortion.h = 0;
 
+    this->__changed();
     return *this;
 }
 
@@ -251,12 +274,14 @@ RenderableObject& RenderableObject::stretch(const i32 d) {
     if(this->targetPortion.w < 0) this->targetPortion.w = 0;
     if(this->targetPortion.h < 0) this->targetPortion.h = 0;
 
+    this->__changed();
     return *this;
 }
 
 
 RenderableObject& RenderableObject::unflip() {
     this->flip = SDL_FLIP_NONE;
+    this->__changed();
     return *this;
 }
 
@@ -264,6 +289,7 @@ RenderableObject& RenderableObject::flipHorizontally() {
     if(this->flip == SDL_FLIP_NONE) this->flip = SDL_FLIP_HORIZONTAL;
     else if(this->flip == SDL_FLIP_HORIZONTAL) this->flip = SDL_FLIP_NONE;
 
+    this->__changed();
     return *this;
 }
 
@@ -271,6 +297,7 @@ RenderableObject& RenderableObject::flipVertically() {
     if(this->flip == SDL_FLIP_NONE) this->flip = SDL_FLIP_VERTICAL;
     else if(this->flip == SDL_FLIP_VERTICAL) this->flip = SDL_FLIP_NONE;
     
+    this->__changed();
     return *this;
 }
 
@@ -282,71 +309,83 @@ RenderableObject& RenderableObject::setModulation(
     this->colorModulation.blue   = blue;
     this->colorModulation.alpha  = alpha;
     
+    this->__changed();
     return *this;
 }
 
 RenderableObject& RenderableObject::setModulation(const u32 rgba) {
     *(u32*)(&this->colorModulation) = rgba; //this is super hacky and may not work on big endian systems, but who cares
     
+    this->__changed();
     return *this;
 }
 
 RenderableObject& RenderableObject::setModulationRed(const u8 mod) {
     this->colorModulation.red = mod;
     
+    this->__changed();
     return *this;
 }
 
 RenderableObject& RenderableObject::setModulationGreen(const u8 mod) {
     this->colorModulation.green = mod;
     
+    this->__changed();
     return *this;
 }
 
 RenderableObject& RenderableObject::setModulationBlue(const u8 mod) {
     this->colorModulation.blue = mod;
     
+    this->__changed();
     return *this;
 }
 
 RenderableObject& RenderableObject::setModulationAlpha(const u8 mod) {
     this->colorModulation.alpha = mod;
     
+    this->__changed();
     return *this;
 }
 
 RenderableObject& RenderableObject::setBlendNone() {
     this->blendMode = SDL_BLENDMODE_NONE;
     
+    this->__changed();
     return *this;
 }
 
 RenderableObject& RenderableObject::setBlendAlpha() {
     this->blendMode = SDL_BLENDMODE_BLEND;
     
+    this->__changed();
     return *this;
 }
 
 RenderableObject& RenderableObject::setBlendAdditive() {
     this->blendMode = SDL_BLENDMODE_ADD;
     
+    this->__changed();
     return *this;
 }
 
 RenderableObject& RenderableObject::setBlendModulate() {
     this->blendMode = SDL_BLENDMODE_MOD;
     
+    this->__changed();
     return *this;
 }
 
 RenderableObject& RenderableObject::setBlendMultiplicative() {
     this->blendMode = SDL_BLENDMODE_MUL;
     
+    this->__changed();
     return *this;
 }
 
 RenderableObject& RenderableObject::setBlendMode(const SDL_BlendMode blendMode) {
     this->blendMode = blendMode;
     
+    this->__changed();
     return *this;
 }
\ No newline at end of file
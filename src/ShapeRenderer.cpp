@@ -0,0 +1,276 @@
+#include "Game/Render/ShapeRenderer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace Structs;
+
+static constexpr double degreesToRadians = 3.14159265358979323846 / 180.0;
+
+/**
+ * @brief Scales unit circle points into an ellipse.
+ * Kept as a plain loop over separate arrays, so that
+ * the compiler can vectorize it.
+ */
+static void transformPoints(
+    const float* sinValues, const float* cosValues, const u32 n,
+    const float centerX, const float centerY, const float rX, const float rY,
+    float* outX, float* outY
+) {
+    for(u32 i = 0; i < n; i++) {
+        outX[i] = centerX + rX * sinValues[i];
+        outY[i] = centerY - rY * cosValues[i];
+    }
+}
+
+size_t ShapeRenderer::ArcKeyHash::operator()(const ArcKey& key) const noexcept {
+    //FNV-1a, keys are zeroed before being filled in, so padding is always 0
+    const u8* bytes = (const u8*)&key;
+    u64 hash = 0xCBF29CE484222325;
+    for(size_t i = 0; i < sizeof(ArcKey); i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3;
+    }
+    return (size_t)hash;
+}
+
+bool ShapeRenderer::ArcKeyEqual::operator()(const ArcKey& a, const ArcKey& b) const noexcept {
+    return memcmp(&a, &b, sizeof(ArcKey)) == 0;
+}
+
+ShapeRenderer::~ShapeRenderer() {
+    for(size_t i = 0; i < this->unitCircles.size(); i++) {
+        free(this->unitCircles[i].sin);
+    }
+}
+
+void ShapeRenderer::setCommandBuffer(RenderCommandBuffer* commands) {
+    if(commands == this->commands) return;
+    this->flush();
+    this->commands = commands;
+}
+
+u32 ShapeRenderer::segmentsFor(const float radius) {
+    //segments no longer than ~4 pixels
+    u32 segments = (u32)ceil(2.0 * 3.14159265358979323846 * (double)radius / 4.0);
+    if(segments < 16) return 16;
+    if(segments > 360) return 360;
+    return segments;
+}
+
+const ShapeRenderer::UnitCircle& ShapeRenderer::__unitCircle(const u32 segments) {
+    for(size_t i = 0; i < this->unitCircles.size(); i++) {
+        if(this->unitCircles[i].segments == segments) return this->unitCircles[i];
+    }
+
+    //both tables in one allocation
+    float* values = (float*)malloc(2 * (segments + 1) * sizeof(float));
+    if(values == nullptr) throw std::bad_alloc();
+    UnitCircle circle = {segments, values, values + segments + 1};
+    for(u32 i = 0; i <= segments; i++) {
+        const double angle = 360.0 * (double)i / (double)segments * degreesToRadians;
+        circle.sin[i] = (float)::sin(angle);
+        circle.cos[i] = (float)::cos(angle);
+    }
+    return this->unitCircles.append(circle);
+}
+
+void ShapeRenderer::__use(SDL_Texture* texture) {
+    if(texture != this->currentTexture) {
+        this->flush();
+        this->currentTexture = texture;
+    }
+}
+
+void ShapeRenderer::__append(const SDL_Vertex* v, const u32 numberOfVertices, const int* i, const u32 numberOfIndices) {
+    const int base = (int)this->vertices.size();
+    for(u32 k = 0; k < numberOfVertices; k++) this->vertices.append(v[k]);
+    for(u32 k = 0; k < numberOfIndices; k++) this->indices.append(base + i[k]);
+    this->stats.shapes++;
+    this->stats.vertices += numberOfVertices;
+}
+
+void ShapeRenderer::__tessellateArc(const ArcKey& key, const float invW, const float invH, CachedArc& out) {
+    const UnitCircle& unit = this->__unitCircle(key.segments);
+    const double step = 360.0 / (double)key.segments;
+
+    double start = key.start, angle = key.end - key.start;
+    if(angle < 0.0) angle += 360.0;
+    const double end = start + angle;
+
+    //table points strictly between both ends, which are computed exactly
+    i64 first = (i64)floor(start / step) + 1;
+    i64 last = (i64)ceil(end / step) - 1;
+    if(last < first) last = first - 1;
+    const u32 inner = (u32)(last - first + 1);
+    const u32 numberOfPoints = inner + 2;
+
+    this->scratchX.clear();
+    this->scratchY.clear();
+    for(u32 i = 0; i < numberOfPoints; i++) {
+        this->scratchX.append(0.0f);
+        this->scratchY.append(0.0f);
+    }
+    float* xs = this->scratchX.data();
+    float* ys = this->scratchY.data();
+
+    const float sinStart = (float)::sin(start * degreesToRadians), cosStart = (float)::cos(start * degreesToRadians);
+    const float sinEnd = (float)::sin(end * degreesToRadians), cosEnd = (float)::cos(end * degreesToRadians);
+    transformPoints(&sinStart, &cosStart, 1, key.centerX, key.centerY, key.radiusX, key.radiusY, xs, ys);
+    transformPoints(&sinEnd, &cosEnd, 1, key.centerX, key.centerY, key.radiusX, key.radiusY, xs + inner + 1, ys + inner + 1);
+
+    //the table may wrap around, in which case it's transformed in 2 contiguous runs
+    u32 done = 0;
+    i64 k = first;
+    while(done < inner) {
+        const u32 index = (u32)(k % (i64)key.segments);
+        const u32 run = std::min(inner - done, key.segments - index);
+        transformPoints(
+            unit.sin + index, unit.cos + index, run,
+            key.centerX, key.centerY, key.radiusX, key.radiusY,
+            xs + 1 + done, ys + 1 + done
+        );
+        done += run;
+        k += run;
+    }
+
+    out.vertices.clear();
+    out.indices.clear();
+
+    const SDL_Color centerColor = *(const SDL_Color*)&key.centerColor;
+    const SDL_Color outerColor = *(const SDL_Color*)&key.outerColor;
+    const bool textured = key.texture != nullptr;
+    out.vertices.append({
+        {key.centerX, key.centerY}, centerColor,
+        {textured ? key.textureCenterX * invW : 0.0f, textured ? key.textureCenterY * invH : 0.0f}
+    });
+    for(u32 i = 0; i < numberOfPoints; i++) {
+        SDL_FPoint texCoord = {0.0f, 0.0f};
+        if(textured) {
+            texCoord = {
+                (key.textureCenterX + xs[i] - key.centerX) * invW,
+                (key.textureCenterY + ys[i] - key.centerY) * invH
+            };
+        }
+        out.vertices.append({{xs[i], ys[i]}, outerColor, texCoord});
+    }
+    for(int i = 1; i < (int)numberOfPoints; i++) {
+        out.indices.append(0);
+        out.indices.append(i);
+        out.indices.append(i + 1);
+    }
+}
+
+void ShapeRenderer::arc(
+    PointF center, float rX, float rY,
+    double start, double end, Color centerColor, Color outerColor,
+    SDL_Texture* srcTex, PointF srcTexCenter, u32 segments
+) {
+    float invW = 0.0f, invH = 0.0f;
+    if(srcTex) {
+        int texWidth, texHeight;
+        if(SDL_QueryTexture(srcTex, nullptr, nullptr, &texWidth, &texHeight)) return;
+        invW = 1.0f / (float)texWidth; invH = 1.0f / (float)texHeight;
+        if(srcTexCenter.x + rX > (float)texWidth || srcTexCenter.x - rX < 0.0f) return; //out-of-bounds
+        if(srcTexCenter.y + rY > (float)texHeight || srcTexCenter.y - rY < 0.0f) return; //out-of-bounds
+    }
+
+    while(start < 0.0) { start += 360.0; }
+    while(start > 360.0) { start -= 360.0; }
+
+    while(end < 0.0) { end += 360.0; }
+    while(end > 360.0) { end -= 360.0; }
+
+    ArcKey key;
+    memset(&key, 0, sizeof(ArcKey));
+    key.centerX = center.x; key.centerY = center.y;
+    key.radiusX = rX; key.radiusY = rY;
+    key.start = start; key.end = end;
+    key.centerColor = centerColor; key.outerColor = outerColor;
+    key.texture = srcTex;
+    if(srcTex) { key.textureCenterX = srcTexCenter.x; key.textureCenterY = srcTexCenter.y; }
+    key.segments = segments != 0 ? segments : segmentsFor(std::max(rX, rY));
+
+    auto found = this->arcCache.find(key);
+    if(found == this->arcCache.end()) {
+        CachedArc tessellation;
+        this->__tessellateArc(key, invW, invH, tessellation);
+        found = this->arcCache.emplace(key, std::move(tessellation)).first;
+    }
+    else this->stats.cacheHits++;
+
+    CachedArc& cached = found->second;
+    cached.lastUsedAt = this->currentFrame;
+
+    this->__use(srcTex);
+    this->__append(
+        cached.vertices.data(), (u32)cached.vertices.size(),
+        cached.indices.data(), (u32)cached.indices.size()
+    );
+}
+
+void ShapeRenderer::line(PointF from, PointF to, float thickness, Color fromColor, Color toColor) {
+    const float dx = to.x - from.x, dy = to.y - from.y;
+    const float length = sqrtf(dx * dx + dy * dy);
+    if(length == 0.0f) return;
+
+    //half of the thickness along the normal
+    const float nx = -dy / length * 0.5f * thickness, ny = dx / length * 0.5f * thickness;
+    const SDL_Color a = *(const SDL_Color*)&fromColor, b = *(const SDL_Color*)&toColor;
+    const SDL_Vertex v[4] = {
+        {{from.x + nx, from.y + ny}, a, {0.0f, 0.0f}},
+        {{to.x + nx, to.y + ny}, b, {0.0f, 0.0f}},
+        {{to.x - nx, to.y - ny}, b, {0.0f, 0.0f}},
+        {{from.x - nx, from.y - ny}, a, {0.0f, 0.0f}}
+    };
+    static constexpr int i[6] = {0, 1, 2, 2, 3, 0};
+
+    this->__use(nullptr);
+    this->__append(v, 4, i, 6);
+}
+
+void ShapeRenderer::polygon(const PointF* points, const u32 numberOfPoints, Color color) {
+    if(points == nullptr || numberOfPoints < 3) return;
+
+    this->__use(nullptr);
+    const SDL_Color c = *(const SDL_Color*)&color;
+    const int base = (int)this->vertices.size();
+    for(u32 k = 0; k < numberOfPoints; k++) {
+        this->vertices.append({{points[k].x, points[k].y}, c, {0.0f, 0.0f}});
+    }
+    //convex, so a triangle fan is enough
+    for(int k = 1; k + 1 < (int)numberOfPoints; k++) {
+        this->indices.append(base);
+        this->indices.append(base + k);
+        this->indices.append(base + k + 1);
+    }
+    this->stats.shapes++;
+    this->stats.vertices += numberOfPoints;
+}
+
+void ShapeRenderer::flush() {
+    if(this->vertices.empty() || this->commands == nullptr) return;
+
+    this->commands->renderGeometry(
+        this->currentTexture,
+        this->vertices.data(), (u32)this->vertices.size(),
+        this->indices.data(), (u32)this->indices.size()
+    );
+    this->stats.drawCalls++;
+    this->vertices.clear();
+    this->indices.clear();
+}
+
+void ShapeRenderer::endFrame() {
+    this->flush();
+    this->stats.cached = this->arcCache.size();
+    this->lastFrameStats = this->stats;
+    this->stats = {};
+
+    this->currentFrame++;
+    for(auto it = this->arcCache.begin(); it != this->arcCache.end();) {
+        if(this->currentFrame - it->second.lastUsedAt > this->evictAfterFrames) it = this->arcCache.erase(it);
+        else ++it;
+    }
+}
\ No newline at end of file
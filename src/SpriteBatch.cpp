@@ -0,0 +1,212 @@
+#include "Game/Render/SpriteBatch.hpp"
+#include "program.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+using namespace Structs;
+
+static ForceInline bool sameColor(const Color a, const Color b) {
+    return a.red == b.red && a.green == b.green && a.blue == b.blue && a.alpha == b.alpha;
+}
+
+static ForceInline bool sameState(const Sprite& a, const Sprite& b) {
+    return a.texture == b.texture && a.blendMode == b.blendMode && sameColor(a.modulation, b.modulation);
+}
+
+static ForceInline bool overlaps(const SDL_Rect& a, const SDL_Rect& b) {
+    return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
+//Cells are at least this many pixels wide and high
+static constexpr i64 minCellSize = 64;
+//and there are at most this many in each direction
+static constexpr i64 maxCellsPerAxis = 64;
+
+static ForceInline u32 colorKey(const Color c) {
+    return ((u32)c.red << 24) | ((u32)c.green << 16) | ((u32)c.blue << 8) | (u32)c.alpha;
+}
+
+void SpriteBatch::add(const Sprite& sprite) {
+    if(sprite.texture == nullptr) return;
+
+    SDL_Rect bounds = sprite.target;
+    if(sprite.angle != 0.0) {
+        //a rotated rectangle always fits in a square
+        //with a side equal to its diagonal
+        const int halfDiagonal = (int)ceil(0.5 * sqrt(
+            (double)sprite.target.w * sprite.target.w + (double)sprite.target.h * sprite.target.h
+        ));
+        bounds.x = sprite.target.x + sprite.target.w / 2 - halfDiagonal;
+        bounds.y = sprite.target.y + sprite.target.h / 2 - halfDiagonal;
+        bounds.w = bounds.h = 2 * halfDiagonal;
+    }
+
+    this->items.append({sprite, bounds, 0, (u32)this->items.size()});
+}
+
+void SpriteBatch::__computeDepths() {
+    //A sprite has to be drawn after every earlier sprite in the same layer
+    //it overlaps. If their states differ, they can't end up in the same group,
+    //so it goes one level deeper. Sprites are sorted by depth before state,
+    //which keeps them in order.
+    //Sprites can only overlap if they share a cell of the grid,
+    //so only those are compared.
+    const u32 n = (u32)this->items.size();
+    i64 minX = LLONG_MAX, minY = LLONG_MAX, maxX = LLONG_MIN, maxY = LLONG_MIN;
+    for(u32 i = 0; i < n; i++) {
+        const SDL_Rect& b = this->items[i].bounds;
+        minX = std::min(minX, (i64)b.x);
+        minY = std::min(minY, (i64)b.y);
+        maxX = std::max(maxX, (i64)b.x + std::max(b.w, 1) - 1);
+        maxY = std::max(maxY, (i64)b.y + std::max(b.h, 1) - 1);
+    }
+    const i64 cellWidth = std::max(minCellSize, (maxX - minX) / maxCellsPerAxis + 1);
+    const i64 cellHeight = std::max(minCellSize, (maxY - minY) / maxCellsPerAxis + 1);
+    const i64 columns = (maxX - minX) / cellWidth + 1;
+    const i64 rows = (maxY - minY) / cellHeight + 1;
+
+    //calls `f(cell)` for every cell the bounds of the sprite cover
+    const auto forEachCell = [&](const SDL_Rect& b, auto f) {
+        const i64 left = ((i64)b.x - minX) / cellWidth, right = ((i64)b.x + std::max(b.w, 1) - 1 - minX) / cellWidth;
+        const i64 top = ((i64)b.y - minY) / cellHeight, bottom = ((i64)b.y + std::max(b.h, 1) - 1 - minY) / cellHeight;
+        for(i64 y = top; y <= bottom; y++) {
+            for(i64 x = left; x <= right; x++) f((size_t)(y * columns + x));
+        }
+    };
+
+    this->cellStarts.assign((size_t)(columns * rows + 1), 0);
+    for(u32 i = 0; i < n; i++) {
+        forEachCell(this->items[i].bounds, [this](const size_t cell) { this->cellStarts[cell + 1]++; });
+    }
+    for(size_t c = 1; c < this->cellStarts.size(); c++) this->cellStarts[c] += this->cellStarts[c - 1];
+    this->cellItems.resize(this->cellStarts.back());
+    //filled in order of submission, using the ends as insertion points
+    for(u32 i = 0; i < n; i++) {
+        forEachCell(this->items[i].bounds, [this, i](const size_t cell) {
+            this->cellItems[this->cellStarts[cell]++] = i;
+        });
+    }
+    for(size_t c = this->cellStarts.size() - 1; c > 0; c--) this->cellStarts[c] = this->cellStarts[c - 1];
+    this->cellStarts[0] = 0;
+
+    this->comparedWith.assign(n, UINT32_MAX);
+    for(u32 i = 0; i < n; i++) {
+        Item& current = this->items[i];
+        u32 depth = 0;
+        forEachCell(current.bounds, [&](const size_t cell) {
+            for(u32 k = this->cellStarts[cell]; k < this->cellStarts[cell + 1]; k++) {
+                const u32 j = this->cellItems[k];
+                if(j >= i) break;
+                if(this->comparedWith[j] == i) continue;
+                this->comparedWith[j] = i;
+
+                const Item& earlier = this->items[j];
+                if(earlier.sprite.layer != current.sprite.layer) continue;
+                if(!overlaps(earlier.bounds, current.bounds)) continue;
+
+                const u32 required = earlier.depth + (sameState(earlier.sprite, current.sprite) ? 0 : 1);
+                if(required > depth) depth = required;
+            }
+        });
+        current.depth = depth;
+    }
+}
+
+SpriteBatch::TextureState& SpriteBatch::__stateOf(SDL_Texture* texture) {
+    //sprites are sorted by texture, so it's most likely the last one
+    const size_t n = this->states.size();
+    if(n > 0 && this->states[n - 1].texture == texture) return this->states[n - 1];
+    const auto [it, inserted] = this->stateIndices.try_emplace(texture, (u32)n);
+    if(!inserted) return this->states[it->second];
+
+    Color mod = Colors::WHITE;
+    SDL_BlendMode blendMode = SDL_BLENDMODE_NONE;
+    {
+        //frames in flight may be changing it
+        std::lock_guard<std::recursive_mutex> lock(Program::getRenderingLock());
+        SDL_GetTextureColorMod(texture, &mod.red, &mod.green, &mod.blue);
+        SDL_GetTextureAlphaMod(texture, &mod.alpha);
+        SDL_GetTextureBlendMode(texture, &blendMode);
+    }
+    return this->states.append({texture, mod, blendMode, mod, blendMode});
+}
+
+void SpriteBatch::flush(RenderCommandBuffer& commands) {
+    this->stats = {};
+    this->stats.sprites = this->items.size();
+    if(this->items.empty()) return;
+
+    this->__computeDepths();
+    std::sort(
+        this->items.data(), this->items.data() + this->items.size(),
+        [](const Item& a, const Item& b) {
+            if(a.sprite.layer != b.sprite.layer) return a.sprite.layer < b.sprite.layer;
+            if(a.depth != b.depth) return a.depth < b.depth;
+            if(a.sprite.texture != b.sprite.texture) return a.sprite.texture < b.sprite.texture;
+            if(a.sprite.blendMode != b.sprite.blendMode) return a.sprite.blendMode < b.sprite.blendMode;
+            const u32 modA = colorKey(a.sprite.modulation), modB = colorKey(b.sprite.modulation);
+            if(modA != modB) return modA < modB;
+            return a.order < b.order;
+        }
+    );
+
+    for(size_t i = 0; i < this->items.size(); i++) {
+        const Sprite& sprite = this->items[i].sprite;
+        TextureState& state = this->__stateOf(sprite.texture);
+        const Color mod = sprite.modulation;
+
+        if(state.modulation.red != mod.red || state.modulation.green != mod.green || state.modulation.blue != mod.blue) {
+            commands.setTextureColorMod(sprite.texture, mod.red, mod.green, mod.blue);
+            this->stats.colorModChanges++;
+        }
+        else if(mod.red != state.originalModulation.red || mod.green != state.originalModulation.green || mod.blue != state.originalModulation.blue) {
+            this->stats.redundantChanges++;
+        }
+
+        if(state.modulation.alpha != mod.alpha) {
+            commands.setTextureAlphaMod(sprite.texture, mod.alpha);
+            this->stats.alphaModChanges++;
+        }
+        else if(mod.alpha != state.originalModulation.alpha) this->stats.redundantChanges++;
+        state.modulation = mod;
+
+        if(state.blendMode != sprite.blendMode) {
+            commands.setTextureBlendMode(sprite.texture, sprite.blendMode);
+            state.blendMode = sprite.blendMode;
+            this->stats.blendModeChanges++;
+        }
+        else if(sprite.blendMode != state.originalBlendMode) this->stats.redundantChanges++;
+
+        commands.renderCopyEx(
+            sprite.texture,
+            &sprite.source,
+            &sprite.target,
+            sprite.angle,
+            sprite.flip
+        );
+    }
+
+    //restore original state, once per texture
+    for(size_t i = 0; i < this->states.size(); i++) {
+        TextureState& state = this->states[i];
+        const Color mod = state.modulation, original = state.originalModulation;
+        if(mod.red != original.red || mod.green != original.green || mod.blue != original.blue) {
+            commands.setTextureColorMod(state.texture, original.red, original.green, original.blue);
+            this->stats.restores++;
+        }
+        if(mod.alpha != original.alpha) {
+            commands.setTextureAlphaMod(state.texture, original.alpha);
+            this->stats.restores++;
+        }
+        if(state.blendMode != state.originalBlendMode) {
+            commands.setTextureBlendMode(state.texture, state.originalBlendMode);
+            this->stats.restores++;
+        }
+    }
+
+    this->states.clear();
+    this->stateIndices.clear();
+    this->items.clear();
+}
\ No newline at end of file
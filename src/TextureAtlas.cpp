@@ -0,0 +1,125 @@
+#include "Game/Render/TextureAtlas.hpp"
+
+#include <algorithm>
+
+using namespace Enums;
+
+Status TextureAtlas::build(SDL_Renderer* renderer, const u32 count, SDL_Texture* const* textures) {
+    this->clear();
+
+    u32 size = this->pageSize;
+    SDL_RendererInfo info;
+    if(SDL_GetRendererInfo(renderer, &info) == 0 && info.max_texture_width > 0 && info.max_texture_height > 0) {
+        size = std::min(size, (u32)std::min(info.max_texture_width, info.max_texture_height));
+    }
+    const float inverseSize = 1.0f / (float)size;
+
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer);
+    u8 red, green, blue, alpha;
+    SDL_GetRenderDrawColor(renderer, &red, &green, &blue, &alpha);
+
+    //current shelf
+    u32 x = 0, y = 0, shelfHeight = 0;
+    SDL_Texture* page = nullptr;
+    Status status = Status::SUCCESS;
+    for(u32 i = 0; i < count; i++) {
+        AtlasRegion region = {nullptr, 0, {0.0f, 0.0f}, {0.0f, 0.0f}};
+        int w, h;
+        if(
+            textures[i] == nullptr ||
+            SDL_QueryTexture(textures[i], nullptr, nullptr, &w, &h) ||
+            (u32)w > size || (u32)h > size
+        ) {
+            this->regions.append(region);
+            continue;
+        }
+
+        if(x + (u32)w > size) {
+            x = 0;
+            y += shelfHeight + 1;
+            shelfHeight = 0;
+        }
+        if(page == nullptr || y + (u32)h > size) {
+            page = SDL_CreateTexture(
+                renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, (int)size, (int)size
+            );
+            if(page == nullptr) {
+                status = Status::SDL_TEXTURE_CREATION_FAILURE;
+                break;
+            }
+            SDL_SetTextureBlendMode(page, SDL_BLENDMODE_BLEND);
+            this->pages.append(page);
+            SDL_SetRenderTarget(renderer, page);
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+            SDL_RenderClear(renderer);
+            x = y = shelfHeight = 0;
+        }
+
+        //copy the texture as it is, including its alpha channel
+        SDL_BlendMode blendMode;
+        SDL_GetTextureBlendMode(textures[i], &blendMode);
+        SDL_SetTextureBlendMode(textures[i], SDL_BLENDMODE_NONE);
+        SDL_Rect target = {(int)x, (int)y, w, h};
+        SDL_RenderCopy(renderer, textures[i], nullptr, &target);
+        SDL_SetTextureBlendMode(textures[i], blendMode);
+
+        region.page = page;
+        region.pageIndex = (u32)this->pages.size() - 1;
+        region.min = {((float)x + 0.5f) * inverseSize, ((float)y + 0.5f) * inverseSize};
+        region.max = {((float)(x + w) - 0.5f) * inverseSize, ((float)(y + h) - 0.5f) * inverseSize};
+        this->regions.append(region);
+
+        x += (u32)w + 1;
+        shelfHeight = std::max(shelfHeight, (u32)h);
+    }
+
+    SDL_SetRenderDrawColor(renderer, red, green, blue, alpha);
+    SDL_SetRenderTarget(renderer, previousTarget);
+
+    if(status != Status::SUCCESS) this->clear();
+    return status;
+}
+
+void TextureAtlas::clear() {
+    for(size_t i = 0; i < this->pages.size(); i++) {
+        SDL_DestroyTexture(this->pages[i]);
+    }
+    this->pages.clear();
+    this->regions.clear();
+}
+
+u32 TileBatch::flush(RenderCommandBuffer& commands, const TextureAtlas& atlas) {
+    return this->flush(commands, atlas.getPages(), atlas.getNumberOfPages());
+}
+
+u32 TileBatch::flush(RenderCommandBuffer& commands, SDL_Texture* const* pages, const u32 numberOfPages) {
+    u32 drawCalls = 0;
+    for(size_t page = 0; page < this->vertices.size(); page++) {
+        Vector<SDL_Vertex>& v = this->vertices[page];
+        if(v.empty()) continue;
+        //the atlas may have been rebuilt with fewer pages meanwhile
+        if(page >= numberOfPages) {
+            v.clear();
+            continue;
+        }
+
+        const size_t numberOfIndices = v.size() / 4 * 6;
+        for(int base = (int)(this->indices.size() / 6 * 4); this->indices.size() < numberOfIndices; base += 4) {
+            this->indices.append(base);
+            this->indices.append(base + 1);
+            this->indices.append(base + 2);
+            this->indices.append(base + 2);
+            this->indices.append(base + 3);
+            this->indices.append(base);
+        }
+
+        commands.renderGeometry(
+            pages[page],
+            v.data(), (u32)v.size(),
+            this->indices.data(), (u32)numberOfIndices
+        );
+        drawCalls++;
+        v.clear();
+    }
+    return drawCalls;
+}
\ No newline at end of file
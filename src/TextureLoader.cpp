@@ -0,0 +1,114 @@
+#include "TextureLoader.hpp"
+#include "Tracing.hpp"
+
+#include <cerrno>
+#include <cstdio>
+
+#include <SDL_image.h>
+
+using namespace Enums;
+
+Status TextureLoader::start(const u32 numberOfWorkers) {
+    this->stop();
+    this->stopping = false;
+    for(u32 i = 0; i < numberOfWorkers || i == 0; i++) {
+        try {
+            this->workers.emplace_back(&TextureLoader::__run, this);
+        }
+        catch(const std::system_error&) {
+            break;
+        }
+    }
+    return this->workers.empty() ? Status::FAILURE : Status::SUCCESS;
+}
+
+void TextureLoader::stop() {
+    if(this->workers.empty()) return;
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopping = true;
+        this->jobs.clear();
+    }
+    this->jobCondition.notify_all();
+    for(std::thread& worker : this->workers) worker.join();
+    this->workers.clear();
+
+    for(TextureLoadResult& result : this->results) {
+        if(result.surface != nullptr) SDL_FreeSurface(result.surface);
+    }
+    this->results.clear();
+}
+
+Status TextureLoader::request(const u32 handle, const char* path) {
+    try {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->jobs.push_back({handle, path});
+            this->requested++;
+        }
+        this->jobCondition.notify_one();
+    }
+    catch(const std::bad_alloc&) {
+        return Status::ALLOC_FAILURE;
+    }
+    return Status::SUCCESS;
+}
+
+bool TextureLoader::poll(TextureLoadResult& result) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if(this->results.empty()) return false;
+    result = std::move(this->results.front());
+    this->results.pop_front();
+    return true;
+}
+
+TextureLoaderStats TextureLoader::getStats() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return {
+        this->requested, this->decoded, this->failed,
+        this->jobs.size() + this->inProgress,
+        0, 0
+    };
+}
+
+void TextureLoader::__run() {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    while(true) {
+        this->jobCondition.wait(lock, [this]() { return this->stopping || !this->jobs.empty(); });
+        if(this->stopping) break;
+
+        Job job = std::move(this->jobs.front());
+        this->jobs.pop_front();
+        this->inProgress++;
+        lock.unlock();
+
+        TextureLoadResult result;
+        result.handle = job.handle;
+        {
+            TraceZone("decode texture");
+            result.surface = IMG_Load(job.path.c_str());
+        }
+        if(result.surface == nullptr) {
+            //SDL's errors are kept per thread, as is errno
+            result.error = IMG_GetError();
+            FILE* f = fopen(job.path.c_str(), "r");
+            if(f != nullptr) {
+                fclose(f);
+                result.status = Status::SDL_IMAGE_LOADTEXTURE_FAILURE;
+            }
+            else result.status = errno == ENOENT ? Status::NONEXISTENT : errno == EACCES ? Status::ACCESS_DENIED : Status::FAILURE;
+        }
+        result.path = std::move(job.path);
+
+        lock.lock();
+        this->inProgress--;
+        if(result.surface != nullptr) this->decoded++;
+        else this->failed++;
+        try {
+            this->results.push_back(std::move(result));
+        }
+        catch(const std::bad_alloc&) {
+            if(result.surface != nullptr) SDL_FreeSurface(result.surface);
+        }
+    }
+}
\ No newline at end of file
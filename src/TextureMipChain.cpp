@@ -0,0 +1,103 @@
+#include "Game/Render/TextureMipChain.hpp"
+
+#include <new>
+
+using namespace Enums;
+
+static void destroyTextures(Vector<SDL_Texture*>& textures) {
+    for(size_t i = 0; i < textures.size(); i++) {
+        if(textures[i] != nullptr) SDL_DestroyTexture(textures[i]);
+    }
+    textures.clear();
+}
+
+Status TextureMipChain::build(SDL_Renderer* renderer, const u32 count, SDL_Texture* const* textures, const u32 size) {
+    this->clear();
+    this->size = size;
+
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer);
+    u8 red, green, blue, alpha;
+    SDL_GetRenderDrawColor(renderer, &red, &green, &blue, &alpha);
+
+    //textures of the previous and the current level
+    Vector<SDL_Texture*> previous(count > 0 ? count : 1), current(count > 0 ? count : 1);
+    Status status = Status::SUCCESS;
+    for(u32 side = size / 2; side >= 1 && this->numberOfLevels < maxLevels; side /= 2) {
+        for(u32 i = 0; i < count && status == Status::SUCCESS; i++) {
+            SDL_Texture* source = this->numberOfLevels == 0 ? textures[i] : previous[i];
+            if(source == nullptr) {
+                current.append(nullptr);
+                continue;
+            }
+
+            SDL_Texture* texture = SDL_CreateTexture(
+                renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, (int)side, (int)side
+            );
+            current.append(texture);
+            if(texture == nullptr) {
+                status = Status::SDL_TEXTURE_CREATION_FAILURE;
+                break;
+            }
+
+            //copied as it is, including its alpha channel, with every pixel
+            //sampled right between the 4 pixels it's made from
+            SDL_BlendMode blendMode;
+            SDL_ScaleMode scaleMode;
+            SDL_GetTextureBlendMode(source, &blendMode);
+            SDL_GetTextureScaleMode(source, &scaleMode);
+            SDL_SetTextureBlendMode(source, SDL_BLENDMODE_NONE);
+            SDL_SetTextureScaleMode(source, SDL_ScaleModeLinear);
+            SDL_SetRenderTarget(renderer, texture);
+            SDL_RenderCopy(renderer, source, nullptr, nullptr);
+            SDL_SetTextureBlendMode(source, blendMode);
+            SDL_SetTextureScaleMode(source, scaleMode);
+        }
+        if(status != Status::SUCCESS) break;
+
+        TextureAtlas* level = new(std::nothrow) TextureAtlas(this->pageSize);
+        if(level == nullptr) {
+            status = Status::ALLOC_FAILURE;
+            break;
+        }
+        this->levels[this->numberOfLevels++] = level;
+        status = level->build(renderer, count, current.data());
+        if(status != Status::SUCCESS) break;
+
+        destroyTextures(previous);
+        for(u32 i = 0; i < count; i++) previous.append(current[i]);
+        current.clear();
+    }
+
+    //the last level is 1x1, i.e. the average color
+    if(status == Status::SUCCESS && this->numberOfLevels > 0) {
+        for(u32 i = 0; i < count; i++) {
+            SDL_Color color = {0, 0, 0, 0};
+            if(previous[i] != nullptr) {
+                SDL_SetRenderTarget(renderer, previous[i]);
+                SDL_RenderReadPixels(renderer, nullptr, SDL_PIXELFORMAT_RGBA32, &color, 4);
+            }
+            this->averageColors.append(color);
+        }
+    }
+
+    destroyTextures(previous);
+    destroyTextures(current);
+    SDL_SetRenderDrawColor(renderer, red, green, blue, alpha);
+    SDL_SetRenderTarget(renderer, previousTarget);
+
+    if(status != Status::SUCCESS) this->clear();
+    return status;
+}
+
+void TextureMipChain::clear() {
+    for(u32 i = 0; i < this->numberOfLevels; i++) delete this->levels[i];
+    this->numberOfLevels = 0;
+    this->averageColors.clear();
+}
+
+const TextureAtlas* TextureMipChain::getLevel(const u32 pixels) const {
+    for(u32 i = 0; i < this->numberOfLevels; i++) {
+        if(this->size >> (i + 1) == pixels) return this->levels[i];
+    }
+    return nullptr;
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#include "Tracing.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+using namespace Enums;
+
+static std::mutex buffersLock;
+static std::vector<std::unique_ptr<TraceBuffer>> buffers;
+
+static TraceBuffer& registerThreadBuffer() {
+    std::lock_guard<std::mutex> lock(buffersLock);
+    buffers.push_back(std::make_unique<TraceBuffer>(SDL_ThreadID()));
+    return *buffers.back();
+}
+
+TraceBuffer& Tracer::getThreadBuffer() {
+    //one buffer per thread, whoever records first
+    static thread_local TraceBuffer& buffer = registerThreadBuffer();
+    return buffer;
+}
+
+static void writeName(FILE* file, const char* name) {
+    for(; *name != '\0'; name++) {
+        if(*name == '"' || *name == '\\') fputc('\\', file);
+        fputc(*name, file);
+    }
+}
+
+Status Tracer::write(const char* path) {
+    typedef struct {
+        SDL_threadID threadID;
+        std::vector<TraceEvent> events;
+    } ThreadEvents;
+    std::vector<ThreadEvents> threads;
+
+    try {
+        std::lock_guard<std::mutex> lock(buffersLock);
+        threads.reserve(buffers.size());
+        for(const std::unique_ptr<TraceBuffer>& buffer : buffers) {
+            ThreadEvents& copy = threads.emplace_back();
+            copy.threadID = buffer->threadID;
+
+            const u64 last = buffer->numberOfEvents.load(std::memory_order_acquire);
+            const u64 first = last > TraceBuffer::capacity ? last - TraceBuffer::capacity : 0;
+            copy.events.resize(last - first);
+            for(u64 i = first; i < last; i++) {
+                const TraceBuffer::Slot& slot = buffer->events[i % TraceBuffer::numberOfSlots];
+                copy.events[i - first] = {
+                    slot.name.load(std::memory_order_relaxed),
+                    slot.begin.load(std::memory_order_relaxed),
+                    slot.end.load(std::memory_order_relaxed)
+                };
+            }
+
+            //the thread may have overwritten the oldest events while they were copied,
+            //the one being written when copying ended included
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const u64 now = buffer->numberOfEvents.load(std::memory_order_relaxed);
+            if(now + 1 > first + TraceBuffer::numberOfSlots) {
+                const u64 overwritten = std::min(now + 1 - TraceBuffer::numberOfSlots, last) - first;
+                copy.events.erase(copy.events.begin(), copy.events.begin() + overwritten);
+            }
+        }
+    }
+    catch(const std::bad_alloc&) {
+        return Status::ALLOC_FAILURE;
+    }
+
+    //timestamps are relative to the earliest zone
+    u64 origin = (u64)-1;
+    for(const ThreadEvents& thread : threads) {
+        for(const TraceEvent& event : thread.events) origin = std::min(origin, event.begin);
+    }
+    const double toMicroseconds = 1000000.0 / (double)SDL_GetPerformanceFrequency();
+
+    FILE* file = fopen(path, "w");
+    if(file == nullptr) return Status::FAILURE;
+
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", file);
+    bool firstEvent = true;
+    for(const ThreadEvents& thread : threads) {
+        for(const TraceEvent& event : thread.events) {
+            fputs(firstEvent ? "\n{\"name\":\"" : ",\n{\"name\":\"", file);
+            firstEvent = false;
+            writeName(file, event.name);
+            fprintf(
+                file, "\",\"ph\":\"X\",\"pid\":1,\"tid\":%lu,\"ts\":%.3f,\"dur\":%.3f}",
+                (unsigned long)thread.threadID,
+                (double)(event.begin - origin) * toMicroseconds,
+                (double)(event.end - event.begin) * toMicroseconds
+            );
+        }
+    }
+    fputs("\n]}\n", file);
+
+    const bool failed = ferror(file) != 0;
+    if(fclose(file) != 0 || failed) return Status::FAILURE;
+    return Status::SUCCESS;
+}
\ No newline at end of file
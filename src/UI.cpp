@@ -2,6 +2,9 @@
 #include "Game/Render/UIElement.hpp"
 #include "Game/Render/UITextElement.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 
 UIElement::UIElement(
     const u32 objectID
@@ -23,12 +26,15 @@ UIElement::UIElement(
     const TextureHandle textureHandle
 ) : RenderableObject(objectID, name, textureHandle) {}
 
-void UIElement::render() {
+void UIElement::update() {
     this->moveOnScreen(
         0,
-        (i32)(5.0 * sin(0.05 * Game::getRenderer().getNumberOfFramesRendered()))
+        (i32)(5.0 * sin(0.12 * Game::getNumberOfTicks()))
     );
-    this->scaleX(2.0f * abs(sinf(0.05f * (float)Game::getRenderer().getNumberOfFramesRendered())) + 0.1f);
+    this->scaleX(2.0f * abs(sinf(0.12f * (float)Game::getNumberOfTicks())) + 0.1f);
+}
+
+void UIElement::render() {
     return; //for now no render logic
 }
 
@@ -56,4 +62,273 @@ UIElement& UIElement::createUIElement(const u32 objectID, const TextureHandle te
 }
 UIElement& UIElement::createUIElement(const u32 objectID, const char* name, const TextureHandle textureHandle) {
     return Game::getRenderer().registerUIElement(UIElement(objectID, name, textureHandle));
+}
+
+UITextElement::UITextElement(
+    const u32 objectID,
+    const FontHandle font
+) : UIElement(objectID), font(font) {}
+
+UITextElement::UITextElement(
+    const u32 objectID,
+    const char* name,
+    const FontHandle font
+) : UIElement(objectID, name), font(font) {}
+
+void UITextElement::__outdate(const u32 paragraph) {
+    this->paragraphs[paragraph].wrapped = false;
+    this->firstOutdatedParagraph = std::min(this->firstOutdatedParagraph, paragraph);
+    this->__changed();
+}
+
+void UITextElement::__dropParagraphs() {
+    while(this->maxParagraphs > 0 && this->paragraphs.size() > this->maxParagraphs) {
+        //lines of paragraphs not laid out yet were never counted
+        if(this->firstOutdatedParagraph > 0) {
+            const u64 lines = this->paragraphs.front().lineStarts.size();
+            this->linesDropped += lines;
+            this->scrollLine -= std::min(this->scrollLine, lines);
+            this->firstOutdatedParagraph--;
+        }
+        this->paragraphs.pop_front();
+    }
+    this->__changed();
+}
+
+UITextElement& UITextElement::append(const char* text) {
+    if(this->paragraphs.empty()) this->paragraphs.emplace_back();
+
+    //only the last paragraph changes, unless new ones are started
+    const char* s = text;
+    while(true) {
+        const char* newline = strchr(s, '\n');
+        const size_t length = newline != nullptr ? (size_t)(newline - s) : strlen(s);
+        this->paragraphs.back().text.append(s, length);
+        this->__outdate((u32)this->paragraphs.size() - 1);
+        if(newline == nullptr) break;
+
+        this->paragraphs.emplace_back();
+        s = newline + 1;
+    }
+    this->__dropParagraphs();
+    return *this;
+}
+
+UITextElement& UITextElement::appendLine(const char* text) {
+    if(!this->paragraphs.empty()) this->paragraphs.emplace_back();
+    return this->append(text);
+}
+
+UITextElement& UITextElement::insert(TextPosition at, const char* text) {
+    if(this->paragraphs.empty()) this->paragraphs.emplace_back();
+    at.paragraph = std::min(at.paragraph, (u32)this->paragraphs.size() - 1);
+    at.offset = std::min(at.offset, (u32)this->paragraphs[at.paragraph].text.size());
+
+    //the rest of the paragraph goes after the inserted text
+    std::string& first = this->paragraphs[at.paragraph].text;
+    std::string rest = first.substr(at.offset);
+    first.erase(at.offset);
+
+    u32 index = at.paragraph;
+    const char* s = text;
+    while(true) {
+        const char* newline = strchr(s, '\n');
+        const size_t length = newline != nullptr ? (size_t)(newline - s) : strlen(s);
+        this->paragraphs[index].text.append(s, length);
+        this->__outdate(index);
+        if(newline == nullptr) break;
+
+        this->paragraphs.emplace(this->paragraphs.begin() + index + 1);
+        index++;
+        s = newline + 1;
+    }
+    this->paragraphs[index].text += rest;
+    this->__dropParagraphs();
+    return *this;
+}
+
+UITextElement& UITextElement::erase(TextPosition from, TextPosition to) {
+    if(this->paragraphs.empty()) return *this;
+    const u32 last = (u32)this->paragraphs.size() - 1;
+    from.paragraph = std::min(from.paragraph, last);
+    from.offset = std::min(from.offset, (u32)this->paragraphs[from.paragraph].text.size());
+    to.paragraph = std::min(to.paragraph, last);
+    to.offset = std::min(to.offset, (u32)this->paragraphs[to.paragraph].text.size());
+    if(to.paragraph < from.paragraph || (to.paragraph == from.paragraph && to.offset < from.offset)) {
+        std::swap(from, to);
+    }
+
+    std::string& first = this->paragraphs[from.paragraph].text;
+    if(from.paragraph == to.paragraph) {
+        first.erase(from.offset, to.offset - from.offset);
+    }
+    else {
+        first.erase(from.offset);
+        first.append(this->paragraphs[to.paragraph].text, to.offset);
+        this->paragraphs.erase(
+            this->paragraphs.begin() + from.paragraph + 1,
+            this->paragraphs.begin() + to.paragraph + 1
+        );
+    }
+    this->__outdate(from.paragraph);
+    return *this;
+}
+
+UITextElement& UITextElement::clear() {
+    this->paragraphs.clear();
+    this->firstOutdatedParagraph = 0;
+    this->linesDropped = 0;
+    this->numberOfLines = 0;
+    this->scrollLine = 0;
+    this->__changed();
+    return *this;
+}
+
+UITextElement& UITextElement::setMaxParagraphs(const u32 maxParagraphs) {
+    this->maxParagraphs = maxParagraphs;
+    this->__dropParagraphs();
+    return *this;
+}
+
+UITextElement& UITextElement::setFont(const FontHandle font) {
+    this->font = font;
+    for(Paragraph& paragraph : this->paragraphs) paragraph.wrapped = false;
+    this->firstOutdatedParagraph = 0;
+    this->__changed();
+    return *this;
+}
+
+UITextElement& UITextElement::scrollTo(const u64 line) {
+    this->scrollLine = line;
+    this->followingEnd = false;
+    this->__changed();
+    return *this;
+}
+
+UITextElement& UITextElement::scrollBy(const i64 lines) {
+    if(lines < 0) {
+        this->scrollLine -= std::min(this->scrollLine, (u64)-lines);
+        this->followingEnd = false;
+    }
+    else {
+        this->scrollLine += (u64)lines;
+        //clamped once drawn
+        const u64 end = this->numberOfLines > this->linesInView ? this->numberOfLines - this->linesInView : 0;
+        if(this->scrollLine >= end) this->followingEnd = true;
+    }
+    this->__changed();
+    return *this;
+}
+
+UITextElement& UITextElement::scrollToEnd() {
+    this->followingEnd = true;
+    this->__changed();
+    return *this;
+}
+
+void UITextElement::__wrap(GlyphAtlas& atlas, RenderCommandBuffer& commands, Paragraph& paragraph, const i32 width) {
+    paragraph.lineStarts.clear();
+    paragraph.lineStarts.push_back(0);
+    paragraph.wrapped = true;
+    if(width <= 0) return;
+
+    const char* text = paragraph.text.c_str();
+    u32 lineStart = 0;
+    //the latest place the line can be broken at, after a space,
+    //and how wide the line is up to it
+    u32 lastBreak = 0;
+    i32 widthAtBreak = 0;
+    i32 x = 0;
+    for(const char* p = text; *p != '\0';) {
+        const u32 offset = (u32)(p - text);
+        const u32 codepoint = GlyphAtlas::decodeUTF8(p);
+        const Glyph* glyph = atlas.getGlyph(commands, codepoint);
+        const i32 advance = glyph != nullptr ? glyph->advance : 0;
+
+        //spaces may hang past the edge, words too long
+        //for a line of their own are broken anywhere
+        if(x + advance > width && offset > lineStart && codepoint != ' ') {
+            if(lastBreak > lineStart) {
+                lineStart = lastBreak;
+                x -= widthAtBreak;
+            }
+            else {
+                lineStart = offset;
+                x = 0;
+            }
+            paragraph.lineStarts.push_back(lineStart);
+        }
+        x += advance;
+        if(codepoint == ' ') {
+            lastBreak = (u32)(p - text);
+            widthAtBreak = x;
+        }
+    }
+}
+
+void UITextElement::__layout(GlyphAtlas& atlas, RenderCommandBuffer& commands) {
+    if(this->targetPortion.w != this->wrappedAt) {
+        for(Paragraph& paragraph : this->paragraphs) paragraph.wrapped = false;
+        this->firstOutdatedParagraph = 0;
+        this->wrappedAt = this->targetPortion.w;
+    }
+
+    //after an append, this is only the last paragraph
+    const u32 size = (u32)this->paragraphs.size();
+    u64 line = this->linesDropped;
+    if(this->firstOutdatedParagraph > 0) {
+        const Paragraph& previous = this->paragraphs[this->firstOutdatedParagraph - 1];
+        line = previous.firstLine + previous.lineStarts.size();
+    }
+    for(u32 i = this->firstOutdatedParagraph; i < size; i++) {
+        Paragraph& paragraph = this->paragraphs[i];
+        if(!paragraph.wrapped) this->__wrap(atlas, commands, paragraph, this->wrappedAt);
+        paragraph.firstLine = line;
+        line += paragraph.lineStarts.size();
+    }
+    this->firstOutdatedParagraph = size;
+    this->numberOfLines = line - this->linesDropped;
+}
+
+void UITextElement::__draw(TextRenderer& text, RenderCommandBuffer& commands) {
+    GlyphAtlas* atlas = text.getAtlas(this->font);
+    if(atlas == nullptr) return;
+    const i32 lineSkip = atlas->getLineSkip();
+    if(lineSkip <= 0) return;
+
+    this->__layout(*atlas, commands);
+
+    const SDL_Rect& r = this->targetPortion;
+    this->linesInView = r.h > 0 ? (u32)(r.h / lineSkip) : 0;
+    const u64 end = this->numberOfLines > this->linesInView ? this->numberOfLines - this->linesInView : 0;
+    if(this->followingEnd || this->scrollLine > end) this->scrollLine = end;
+    if(this->linesInView == 0 || this->paragraphs.empty()) return;
+
+    //only lines in view are laid out, starting in the paragraph with the first one
+    const u64 first = this->scrollLine + this->linesDropped;
+    const auto it = std::upper_bound(
+        this->paragraphs.begin(), this->paragraphs.end(), first,
+        [](const u64 line, const Paragraph& paragraph) { return line < paragraph.firstLine; }
+    );
+    size_t index = (size_t)(it - this->paragraphs.begin()) - 1;
+    size_t k = (size_t)(first - this->paragraphs[index].firstLine);
+
+    u32 drawn = 0;
+    for(; index < this->paragraphs.size() && drawn < this->linesInView; index++, k = 0) {
+        const Paragraph& paragraph = this->paragraphs[index];
+        for(; k < paragraph.lineStarts.size() && drawn < this->linesInView; k++, drawn++) {
+            const u32 start = paragraph.lineStarts[k];
+            const u32 end = k + 1 < paragraph.lineStarts.size() ?
+                paragraph.lineStarts[k + 1] : (u32)paragraph.text.size();
+            const SDL_FPoint position = {(float)r.x, (float)(r.y + (i32)drawn * lineSkip)};
+            (void)atlas->draw(commands, paragraph.text.data() + start, end - start, position, this->textColor);
+        }
+    }
+}
+
+UITextElement& UITextElement::createUITextElement(const u32 objectID, const FontHandle font) {
+    return Game::getRenderer().registerUITextElement(UITextElement(objectID, font));
+}
+UITextElement& UITextElement::createUITextElement(const u32 objectID, const char* name, const FontHandle font) {
+    return Game::getRenderer().registerUITextElement(UITextElement(objectID, name, font));
 }
\ No newline at end of file
@@ -1,44 +1,262 @@
 #include "Game/World.hpp"
+#include "Testing.h"
+#include "Tracing.hpp"
+
+#include <chrono>
 
 using namespace Enums;
 using namespace Structs;
 
-Status World::populateChunk(const ChunkPos which, const u32 blockID) {
-    Chunk* chunk = this->chunks[which];
-    if(chunk != nullptr) return Status::ALREADY_EXISTS;
-
-    chunk = (Chunk*)malloc(sizeof(Chunk));
-    if(chunk == nullptr) return Status::ALLOC_FAILURE;
+Chunk* World::getOrCreateChunk(const ChunkPos which, const u32 blockID) {
+    Chunk* chunk = this->chunks.find(which);
+    if(chunk != nullptr) return chunk;
 
     //for now the entire chunk will be made with just 1 block
     //this will change when a proper procedural world generation
     //will be implemented
-    memset(chunk, blockID, sizeof(Chunk));
+    chunk = this->chunkPool.create(blockID);
+    if(chunk == nullptr) return nullptr;
     
-    this->chunks[which] = chunk;
+    try {
+        this->chunks.insert(which, chunk);
+    }
+    catch(const std::bad_alloc&) {
+        this->chunkPool.destroy(chunk);
+        return nullptr;
+    }
+    return chunk;
+}
+
+Status World::unloadChunk(const ChunkPos which) {
+    Chunk* chunk = this->chunks.erase(which);
+    if(chunk == nullptr) return Status::NONEXISTENT;
+
+    this->chunkPool.destroy(chunk);
+    this->numberOfUnloads++;
     return Status::SUCCESS;
 }
 
-const Block* World::getBlockAt(i32 x, i32 y) {
-    const Chunk* chunk = this->getChunk(x >= 0 ? x/16 : x/16 - 1, y >= 0 ? y/16 : y/16 - 1);
+Status World::populateChunk(const ChunkPos which, const u32 blockID) {
+    TraceFunction();
+    if(this->chunks.contains(which)) return Status::ALREADY_EXISTS;
+
+    return this->getOrCreateChunk(which, blockID) != nullptr
+        ? Status::SUCCESS
+        : Status::ALLOC_FAILURE;
+}
+
+const Block* World::getBlockAt(i32 x, i32 y) const {
+    const Chunk* chunk = this->getChunk(getChunkPosOf(x, y));
     if(chunk == nullptr) return nullptr;
 
-    return Blocks::getBlockWithID(
-        chunk->blockIDs[y >= 0 ? y%16 : y%16 + 16][x >= 0 ? x%16 : x%16 + 16]
-    );
+    Point p = getPositionInChunk(x, y);
+    return Blocks::getBlockWithID(chunk->getBlockID(p.x, p.y));
+}
+
+Status World::setBlockAt(i32 x, i32 y, u32 blockID) {
+    Chunk* chunk = this->chunks.find(getChunkPosOf(x, y));
+    if(chunk == nullptr) return Status::NONEXISTENT;
+
+    Point p = getPositionInChunk(x, y);
+    return chunk->setBlockID(p.x, p.y, blockID);
+}
+
+size_t World::getChunkMemoryUsage() const {
+    size_t bytes = 0;
+    this->chunks.forEach([&bytes](ChunkPos, const Chunk* chunk) {
+        bytes += chunk->getMemoryUsage();
+    });
+    return bytes;
 }
 
-void World::printChunk(i32 x, i32 y) {
+void World::printChunk(i32 x, i32 y) const {
     Logger& logger = Program::getLogger();
-    const Chunk* chunk = this->chunks[{x, y}];
+    const Chunk* chunk = this->getChunk(x, y);
     if(chunk == nullptr) {
         logger.print("No chunk\n");
         return;
     }
-    for(int i = 0; i < 16; i++) {
-        for(int j = 0; j < 16; j++) {
-            logger.print(chunk->blockIDs[i][j], " ");
+    for(u32 i = 0; i < Chunk::size; i++) {
+        for(u32 j = 0; j < Chunk::size; j++) {
+            logger.print(chunk->getBlockID(j, i), " ");
         }
         logger.print("\n");
     }
-}
\ No newline at end of file
+}
+
+
+TEST(WorldChunkIndex) {
+    World world(0);
+    for(i32 x = -8; x < 8; x++) {
+        ASSERT_EQ(world.populateChunk({x, 0}, 1), Status::SUCCESS);
+    }
+    EXPECT_EQ(world.populateChunk({0, 0}, 2), Status::ALREADY_EXISTS);
+    const ChunkIndexStats before = world.getChunkIndexStats();
+    EXPECT_EQ(before.chunks, 16);
+
+    //panning over empty space only ever reads the index
+    u64 queries = 0;
+    for(i32 y = -64; y < 64; y++) {
+        if(y == 0) continue;
+        for(i32 x = -64; x < 64; x++) {
+            EXPECT_EQ(world.getChunk(x, y), nullptr);
+            EXPECT_EQ(world.getBlockAt(x * (i32)Chunk::size, y * (i32)Chunk::size), nullptr);
+            queries += 2;
+        }
+    }
+    const ChunkIndexStats after = world.getChunkIndexStats();
+    EXPECT_EQ(after.chunks, before.chunks);
+    EXPECT_EQ(after.slots, before.slots);
+    EXPECT_EQ(after.growths, before.growths);
+    EXPECT_EQ(after.lookups - before.lookups, queries);
+    EXPECT_EQ(after.misses - before.misses, queries);
+
+    //only explicit creation adds chunks
+    const Chunk* existing = world.getChunk(3, 0);
+    EXPECT_NEQ(existing, nullptr);
+    EXPECT_EQ(world.getOrCreateChunk({3, 0}, 5), existing);
+    EXPECT_EQ(world.getChunkIndexStats().chunks, 16);
+    EXPECT_NEQ(world.getOrCreateChunk({3, 1}, 5), nullptr);
+    EXPECT_EQ(world.getChunkIndexStats().chunks, 17);
+
+    //unloaded chunks are gone and their memory is reused
+    EXPECT_EQ(world.unloadChunk({3, 1}), Status::SUCCESS);
+    EXPECT_EQ(world.unloadChunk({3, 1}), Status::NONEXISTENT);
+    EXPECT_EQ(world.getChunk(3, 1), nullptr);
+    const u64 recycled = world.getChunkPoolStats().recycled;
+    EXPECT_NEQ(world.getOrCreateChunk({3, 1}, 5), nullptr);
+    EXPECT_EQ(world.getChunkPoolStats().recycled, recycled + 1);
+}
+
+//ID every block of the test world is set to, distinct within every chunk
+static u32 testBlockID(const i32 x, const i32 y) {
+    const ChunkPos chunk = World::getChunkPosOf(x, y);
+    const Point p = World::getPositionInChunk(x, y);
+    return (u32)(p.x + p.y * (i32)Chunk::size) + 1000 * (u32)(chunk.x + 2 + 3 * (chunk.y + 2));
+}
+
+TEST(WorldBlockRows) {
+    World world(0);
+    //chunks -2..0 on both axes, except (-1, 0)
+    for(i32 cy = -2; cy <= 0; cy++) {
+        for(i32 cx = -2; cx <= 0; cx++) {
+            if(cx == -1 && cy == 0) continue;
+            ASSERT_EQ(world.populateChunk({cx, cy}, 0), Status::SUCCESS);
+        }
+    }
+    for(i32 y = -32; y < 16; y++) {
+        for(i32 x = -32; x < 16; x++) {
+            (void)world.setBlockAt(x, y, testBlockID(x, y));
+        }
+    }
+
+    //crosses chunk borders at -16 and 0 on both axes
+    const i32 minX = -20, minY = -17, maxX = 3, maxY = 0;
+    const i32 width = maxX - minX + 1, height = maxY - minY + 1;
+    bool visited[18][24] = {};
+    i32 previousChunkX = INT32_MIN, previousChunkY = INT32_MIN, previousY = INT32_MIN;
+    bool ordered = true;
+    world.forEachBlockRow(minX, minY, maxX, maxY, [&](const i32 x, const i32 y, [[maybe_unused]] const u32* blockIDs, const u32 count) {
+        EXPECT_NEQ(count, 0);
+        EXPECT_EQ(count <= Chunk::size, true);
+        EXPECT_EQ(x >= minX && x + (i32)count - 1 <= maxX && y >= minY && y <= maxY, true);
+        //a run never leaves its chunk
+        const ChunkPos chunk = World::getChunkPosOf(x, y);
+        EXPECT_EQ(World::getChunkPosOf(x + (i32)count - 1, y).x, chunk.x);
+        EXPECT_NEQ(world.getChunk(chunk), nullptr);
+
+        //rows of chunks, then chunks, then block rows
+        if(chunk.y < previousChunkY) ordered = false;
+        else if(chunk.y == previousChunkY) {
+            if(chunk.x < previousChunkX) ordered = false;
+            else if(chunk.x == previousChunkX && y <= previousY) ordered = false;
+        }
+        previousChunkX = chunk.x;
+        previousChunkY = chunk.y;
+        previousY = y;
+
+        for(u32 i = 0; i < count; i++) {
+            EXPECT_EQ(blockIDs[i], testBlockID(x + (i32)i, y));
+            bool& seen = visited[y - minY][x + (i32)i - minX];
+            EXPECT_EQ(seen, false);
+            seen = true;
+        }
+    });
+    EXPECT_EQ(ordered, true);
+    for(i32 y = 0; y < height; y++) {
+        for(i32 x = 0; x < width; x++) {
+            const bool exists = world.getChunk(World::getChunkPosOf(minX + x, minY + y)) != nullptr;
+            EXPECT_EQ(visited[y][x], exists);
+        }
+    }
+
+    //single blocks on both sides of the border at -16
+    u32 calls = 0, id = 0;
+    const auto single = [&](const i32, const i32, const u32* blockIDs, [[maybe_unused]] const u32 count) {
+        calls++;
+        EXPECT_EQ(count, 1);
+        id = blockIDs[0];
+    };
+    world.forEachBlockRow(-16, -16, -16, -16, single);
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(id, testBlockID(-16, -16));
+    world.forEachBlockRow(-17, -17, -17, -17, single);
+    EXPECT_EQ(calls, 2);
+    EXPECT_EQ(id, testBlockID(-17, -17));
+
+    //empty rectangles and missing chunks call nothing
+    world.forEachBlockRow(1, 0, 0, 0, single);
+    world.forEachBlockRow(0, 1, 0, 0, single);
+    world.forEachBlockRow(-16, 0, -1, 15, single);
+    EXPECT_EQ(calls, 2);
+}
+
+BENCH(WorldBlockRows) {
+    //a 4K viewport at minimum zoom, 3.2 pixels per block
+    constexpr i32 width = 1200, height = 675;
+    constexpr u32 frames = 50;
+    World world(0);
+    for(i32 cy = -1; cy <= height / (i32)Chunk::size + 1; cy++) {
+        for(i32 cx = -1; cx <= width / (i32)Chunk::size + 1; cx++) {
+            (void)world.populateChunk({cx, cy}, 1);
+        }
+    }
+    for(i32 y = 0; y < height; y++) {
+        for(i32 x = 0; x < width; x++) (void)world.setBlockAt(x, y, (u32)((x * 7 + y * 3) % 11));
+    }
+
+    volatile u64 sink = 0;
+    u64 found = 0, visited = 0;
+    const ChunkIndexStats before = world.getChunkIndexStats();
+    auto start = std::chrono::steady_clock::now();
+    for(u32 f = 0; f < frames; f++) {
+        for(i32 y = 0; y < height; y++) {
+            for(i32 x = 0; x < width; x++) found += world.getBlockAt(x, y) != nullptr;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    const double perBlock = std::chrono::duration<double, std::milli>(end - start).count() / frames;
+    sink = sink + found;
+    const ChunkIndexStats between = world.getChunkIndexStats();
+
+    start = std::chrono::steady_clock::now();
+    for(u32 f = 0; f < frames; f++) {
+        world.forEachBlockRow(0, 0, width - 1, height - 1, [&](const i32, const i32, const u32*, const u32 count) {
+            visited += count;
+        });
+    }
+    end = std::chrono::steady_clock::now();
+    const double perRow = std::chrono::duration<double, std::milli>(end - start).count() / frames;
+    const ChunkIndexStats after = world.getChunkIndexStats();
+    EXPECT_EQ(visited, (u64)frames * width * height);
+
+    BENCH_REPORT("%d blocks, per frame:", width * height);
+    BENCH_REPORT(
+        "getBlockAt() per block: %.2f ms, %llu chunk lookups", perBlock,
+        (unsigned long long)((between.lookups - before.lookups) / frames)
+    );
+    BENCH_REPORT(
+        "forEachBlockRow():      %.2f ms, %llu chunk lookups", perRow,
+        (unsigned long long)((after.lookups - between.lookups) / frames)
+    );
+}
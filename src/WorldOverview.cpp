@@ -0,0 +1,125 @@
+#include "Game/Render/WorldOverview.hpp"
+
+#include <cstring>
+
+using namespace Structs;
+
+SDL_Texture* WorldOverview::get(
+    RenderCommandBuffer& commands, const World& world, const ChunkPos region,
+    const TextureMipChain& colors, u32* numberOfChunks
+) {
+    //versions are unique and only ever grow, so the sum changes
+    //whenever a chunk of the region changes, appears or disappears
+    const Chunk* chunks[regionSize * regionSize];
+    u64 versionSum = 0;
+    u32 n = 0;
+    for(u32 cy = 0; cy < regionSize; cy++) {
+        for(u32 cx = 0; cx < regionSize; cx++) {
+            const Chunk* chunk = world.getChunk(
+                region.x * (i32)regionSize + (i32)cx, region.y * (i32)regionSize + (i32)cy
+            );
+            chunks[cy * regionSize + cx] = chunk;
+            if(chunk == nullptr) continue;
+            versionSum += (u64)chunk->getVersion() + 1;
+            n++;
+        }
+    }
+    if(numberOfChunks != nullptr) *numberOfChunks = n;
+    if(n == 0) return nullptr;
+
+    Entry* entry = this->index.find(region);
+    if(entry != nullptr) {
+        entry->lastUsedAt = this->currentFrame;
+        if(entry->versionSum == versionSum && entry->numberOfChunks == n) {
+            this->hits++;
+            return entry->texture;
+        }
+    }
+    else {
+        entry = this->__acquire(commands, region);
+        if(entry == nullptr) {
+            this->overflows++;
+            return nullptr;
+        }
+        this->index.insert(region, entry);
+        entry->lastUsedAt = this->currentFrame;
+    }
+
+    memset(this->pixels, 0, sizeof(this->pixels));
+    u32 blockIDs[Chunk::size];
+    for(u32 cy = 0; cy < regionSize; cy++) {
+        for(u32 cx = 0; cx < regionSize; cx++) {
+            const Chunk* chunk = chunks[cy * regionSize + cx];
+            if(chunk == nullptr) continue;
+
+            u32 lastBlockID = (u32)-1;
+            SDL_Color lastColor = {0, 0, 0, 0};
+            for(u32 y = 0; y < Chunk::size; y++) {
+                chunk->getBlockIDs(0, y, Chunk::size, blockIDs);
+                //the world's Y axis points up, the image's points down
+                SDL_Color* row = &this->pixels[
+                    (regionPixels - 1 - (cy * Chunk::size + y)) * regionPixels + cx * Chunk::size
+                ];
+                for(u32 x = 0; x < Chunk::size; x++) {
+                    if(blockIDs[x] != lastBlockID) {
+                        lastBlockID = blockIDs[x];
+                        lastColor = colors.getAverageColor(lastBlockID);
+                    }
+                    row[x] = lastColor;
+                }
+            }
+        }
+    }
+
+    //a new texture instead of updating the old one,
+    //which frames in flight may still be drawing
+    SDL_Texture* texture = commands.createTexture(
+        SDL_PIXELFORMAT_RGBA32, (int)regionPixels, (int)regionPixels,
+        this->pixels, (int)(regionPixels * sizeof(SDL_Color))
+    );
+    //keep the outdated image, generating it is retried next frame
+    if(texture == nullptr) return entry->texture;
+
+    commands.setTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    commands.destroyTexture(entry->texture);
+    entry->texture = texture;
+    entry->versionSum = versionSum;
+    entry->numberOfChunks = n;
+    this->builds++;
+    return texture;
+}
+
+void WorldOverview::clear() {
+    for(size_t i = 0; i < this->entries.size(); i++) {
+        if(this->entries[i].texture != nullptr) SDL_DestroyTexture(this->entries[i].texture);
+    }
+    this->entries.clear();
+    this->index.clear();
+}
+
+WorldOverview::Entry* WorldOverview::__acquire(RenderCommandBuffer& commands, const ChunkPos position) {
+    Entry* entry = nullptr;
+    if(this->entries.size() < this->capacity) {
+        entry = &this->entries.emplaceBack();
+        entry->texture = nullptr;
+    }
+    else {
+        //the least recently used region not drawn in this frame
+        for(size_t i = 0; i < this->entries.size(); i++) {
+            Entry& candidate = this->entries[i];
+            if(candidate.lastUsedAt == this->currentFrame) continue;
+            if(entry == nullptr || candidate.lastUsedAt < entry->lastUsedAt) entry = &candidate;
+        }
+        if(entry == nullptr) return nullptr;
+
+        this->index.erase(entry->position);
+        commands.destroyTexture(entry->texture);
+        entry->texture = nullptr;
+        this->evictions++;
+    }
+
+    entry->position = position;
+    entry->versionSum = 0;
+    entry->numberOfChunks = 0;
+    return entry;
+}
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "Game/Main/GameObject.hpp"
 #include "Game/Physics/PhysicalObject.hpp"
 #include "Game/Render/UIElement.hpp"
+#include "Tracing.hpp"
 
 using namespace Enums;
 using namespace Structs;
@@ -9,11 +10,17 @@ using namespace Structs;
 MainRegistry Game::registry;
 GameRenderer Game::renderer;
 InputHandler Game::inputHandler;
+u64 Game::numberOfTicks = 0;
 
 Keymap testKeymap;
 
 
-Game::~Game() {}
+Game::~Game() {
+    //cached textures have to go before the rendering context does,
+    //frames still in flight may destroy some of them too
+    this->renderer.stopRenderThread();
+    this->renderer.releaseTextures();
+}
 
 Status Game::init() {
     Status s = this->initSystems();
@@ -21,11 +28,51 @@ Status Game::init() {
 
     this->registry.init();
 
+    if(this->renderer.buildBlockAtlas(this->renderingContext) != Status::SUCCESS) {
+        //not fatal, blocks will be drawn one by one
+        this->logger.warn("Failed to build the block atlas: ", SDL_GetError());
+    }
+
+    if(this->renderer.startRenderThread(this->renderingContext, this->flags.renderThread) != Status::SUCCESS) {
+        //not fatal either, frames will be executed right after being recorded
+        this->logger.warn("Failed to start the render thread");
+    }
+
     return s;
 }
 
+void Game::tick() {
+    TraceFunction();
+    this->renderer.beginTick();
+    this->inputHandler.processHeldKeys(*this);
+    this->renderer.uiElements.forEach([](UIElement& element) { element.update(); });
+    this->renderer.uiTextElements.forEach([](UITextElement& element) { element.update(); });
+    Game::numberOfTicks++;
+}
+
+Status Game::setVSync(const bool enabled) {
+    std::lock_guard<std::recursive_mutex> lock(Program::getRenderingLock());
+    if(SDL_RenderSetVSync(this->renderingContext, enabled ? 1 : 0) != 0) {
+        return Status::SDL_FAILURE;
+    }
+    this->framePacer.setMode(enabled ? FramePacingMode::VSYNC : FramePacingMode::SLEEP);
+    return Status::SUCCESS;
+}
+
+Status Game::saveFrame(const char* path) {
+    if(this->frameSurface == nullptr) return Status::FAILURE;
+
+    this->renderer.waitForSubmittedFrames();
+    std::lock_guard<std::recursive_mutex> lock(Program::getRenderingLock());
+    if(SDL_SaveBMP(this->frameSurface, path) != 0) return Status::SDL_FAILURE;
+    return Status::SUCCESS;
+}
+
 void Game::run() {
-    i64 start = 0, end = 0, delta = 0, overhead = 0, frameTime = 0;
+    i64 start = 0;
+    //Time not simulated yet, less than one tick after simulating
+    i64 accumulator = 0, tickLength = 0;
+    i64 previousStart = SDL_GetPerformanceCounter();
     
     {
         KeyboardKey keys[3] = {KeyboardKey_LCTRL, KeyboardKey_LSHIFT, KeyboardKey_C};
@@ -56,33 +103,84 @@ void Game::run() {
     UIElement& obj = UIElement::createUIElement(MainRegistry::someObjectID, MainRegistry::gregTextureIndex);
     obj.setSizeOnScreen(400, 400).setPositionOnScreenCentered(640, 360);
 
-    TextureHandle tex = Program::getResourceManager().createTextTexture(u"That will be 5€.", 0, MainRegistry::consolasFontIndex, Colors::RED, 480);
+    TextureHandle tex = Program::getResourceManager().acquireTextTexture(u"That will be 5€.", MainRegistry::consolasFontIndex, Colors::RED, 480);
     UIElement& t = UIElement::createUIElement(MainRegistry::someObjectID, "Hello there", tex);
     Size s = Program::getResourceManager().getTextureOriginalSize(tex);
     t.setSizeOnScreen(s).setPositionOnScreen(0, 400);
 
+    UITextElement& console = UITextElement::createUITextElement(MainRegistry::someObjectID, "Console", MainRegistry::consolasFontIndex);
+    console.setSizeOnScreen(480, 160).setPositionOnScreen(0, 520);
+    console.setMaxParagraphs(1000).appendLine("Console ready.");
+
     this->world.populateChunk({0, 0}, Blocks::cobblestone->getInstanceID());
     this->world.populateChunk({1, 1}, Blocks::cobblestone->getInstanceID());
     ///End of section for testing ///
 
     while(this->flags.running) {
+        TraceZone("frame");
         start = SDL_GetPerformanceCounter();
-        frameTime = this->clockFrequency / this->renderer.fps;
-        
-        
+        //headless frames aren't shown anywhere, so there's nothing to pace them to
+        this->framePacer.setFrameRate(this->flags.headless ? 0 : this->renderer.fps);
+        tickLength = this->clockFrequency / this->ticksPerSecond;
+
+        accumulator += start - previousStart;
+        previousStart = start;
+        if(accumulator > (i64)this->maxTicksPerFrame * tickLength) {
+            accumulator = (i64)this->maxTicksPerFrame * tickLength;
+        }
+        //exactly one tick per frame, so that headless runs render
+        //the same frames regardless of how long they take
+        if(this->flags.headless) Unlikely accumulator = tickLength;
         
-        this->inputHandler.processInput(*this);
-        if(!this->flags.paused) Likely this->renderer.renderInPlace(*this);
-        
-
-
-        end = SDL_GetPerformanceCounter();
-        //Delta = Target frametime - Time elapsed - Overhead from previous frames
-        delta = frameTime - (end - start) - overhead;
-        delta = delta * (i64)1000 / (i64)this->clockFrequency;
-        if(delta > 0) sleep(delta);
-
-        end = SDL_GetPerformanceCounter();
-        overhead = end - start - frameTime;
+        //While paused or minimized, the loop blocks on events instead
+        //of spinning at full frame rate. Paused games don't simulate
+        //anything, minimized ones keep simulating, just without rendering.
+        const bool idle = this->flags.paused || this->flags.minimized;
+        FrameProfiler& profiler = this->renderer.getFrameProfiler();
+        profiler.beginFrame();
+        {
+            FrameProfiler::Scope scope(profiler, FrameStage::INPUT);
+            //rounded to the nearest millisecond, which is never 0 for the allowed rates
+            const u32 idleTimeout = (1000 + this->idleLoopRate / 2) / this->idleLoopRate;
+            this->inputHandler.processInput(*this, idle ? idleTimeout : 0);
+        }
+
+        //the simulation advances in fixed steps, however long frames take
+        if(this->flags.paused) Unlikely accumulator = 0;
+        {
+            FrameProfiler::Scope scope(profiler, FrameStage::SIMULATION);
+            while(accumulator >= tickLength) {
+                this->tick();
+                accumulator -= tickLength;
+            }
+        }
+
+        if(this->flags.paused || this->flags.minimized) Unlikely {
+            //idle frames would only skew frame time statistics
+            this->framePacer.reset();
+            continue;
+        }
+        this->renderer.renderInPlace(*this, (double)accumulator / (double)tickLength);
+        {
+            TraceZone("pacing");
+            this->framePacer.endFrame();
+        }
+
+        this->numberOfFrames++;
+        if(this->frameLimit > 0 && this->numberOfFrames >= this->frameLimit) Unlikely {
+            this->flags.running = false;
+        }
     }
+
+    const FramePacerStats stats = this->framePacer.getStats();
+    this->logger.info(
+        "Frame times of the last ", stats.frames, " frames: mean ", stats.mean,
+        " ms, stddev ", stats.stddev, " ms, p99 ", stats.p99, " ms, max ", stats.max, " ms"
+    );
+    this->renderer.getFrameProfiler().dump();
+
+#ifdef TRACING
+    if(Tracer::write("./log/trace.json") == Status::SUCCESS) this->logger.info("Trace written to ./log/trace.json");
+    else this->logger.error("Failed to write the trace to ./log/trace.json");
+#endif /* TRACING */
 }
\ No newline at end of file
@@ -43,7 +43,7 @@ void MainRegistry::init() {
     /* Texture IDs section */
     /////////////////////////
     MainRegistry::gregTextureIndex = Program::getResourceManager().registerTexture("./assets/abruz.png", TextureFlags_LoadImmediately);
-    MainRegistry::stoneTextureIndex = Program::getResourceManager().registerTexture("./assets/cobblestone.png", TextureFlags_LoadImmediately);
+    MainRegistry::stoneTextureIndex = Program::getResourceManager().registerTexture("./assets/cobblestone.png", TextureFlags_LoadImmediately | TextureFlags_Pinned);
 
     /////////////////////////
     /*   Font IDs section  */
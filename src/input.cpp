@@ -327,7 +327,7 @@ EventNotifier<1>* Keymap::getKeyCombinationCallbacks(const u64 combination) cons
 }
 
 
-void InputHandler::processInput(Game& game) {
+void InputHandler::processInput(Game& game, const u32 timeout) {
     //Aliases
     #define latestEvent latestEvents.buffer[latestEvents.index]
     constexpr size_t bufferSize = sizeof(latestEvents.buffer) / sizeof(SDL_Event);
@@ -343,7 +343,11 @@ void InputHandler::processInput(Game& game) {
     //Hence, this boolean.
     bool anyKeyPressed = false;
 
-    while(SDL_PollEvent(&latestEvent)) {
+    //only the first event is waited for, the rest are just drained
+    bool hasEvent = timeout > 0 ?
+        SDL_WaitEventTimeout(&latestEvent, (int)timeout) == 1 :
+        SDL_PollEvent(&latestEvent) == 1;
+    for(; hasEvent; hasEvent = SDL_PollEvent(&latestEvent) == 1) {
         switch(latestEvent.type) {
             case SDL_QUIT:
                 game.flags.running = false;
@@ -361,9 +365,29 @@ void InputHandler::processInput(Game& game) {
                         );
                         break;
                     case SDL_WINDOWEVENT_MINIMIZED:
+                    case SDL_WINDOWEVENT_HIDDEN:
+                        //nothing to render into, see Game::run()
+                        game.flags.minimized = true;
+                        break;
+                    case SDL_WINDOWEVENT_RESTORED:
+                    case SDL_WINDOWEVENT_MAXIMIZED:
+                    case SDL_WINDOWEVENT_SHOWN:
+                        game.flags.minimized = false;
+                        game.renderer.requestRedraw();
+                        break;
+                    case SDL_WINDOWEVENT_EXPOSED:
+                    case SDL_WINDOWEVENT_SIZE_CHANGED:
+                        //the window's contents may have been lost
+                        game.renderer.requestRedraw();
                         break;
                 }
                 break;
+            case SDL_RENDER_TARGETS_RESET:
+            case SDL_RENDER_DEVICE_RESET:
+                //contents of target textures are lost
+                game.renderer.releaseTextures();
+                (void)game.renderer.buildBlockAtlas(game.getRenderingContext());
+                break;
                 
             case SDL_KEYDOWN: {
                 anyKeyPressed = true;
@@ -448,6 +472,15 @@ void InputHandler::processInput(Game& game) {
                     if(game.flags.paused) game.flags.paused = false;
                     else game.flags.paused = true;
                 }
+                else if(latestEvent.key.keysym.sym == SDLK_F3 && latestEvent.key.repeat == 0) {
+                    game.renderer.setProfilerOverlayVisible(!game.renderer.isProfilerOverlayVisible());
+                }
+                else if(latestEvent.key.keysym.sym == SDLK_F4 && latestEvent.key.repeat == 0) {
+                    game.renderer.getFrameProfiler().dump();
+                }
+                else if(latestEvent.key.keysym.sym == SDLK_F5 && latestEvent.key.repeat == 0) {
+                    game.renderer.setRenderTestVisible(!game.renderer.isRenderTestVisible());
+                }
                 break;
             }
 
@@ -509,17 +542,22 @@ void InputHandler::processInput(Game& game) {
     }
 
     game.updateMouse();
-    
-    const u8* keyboardState = Program::getKeyboardState();
-
-    if(keyboardState[SDL_SCANCODE_RIGHT])  game.renderer.moveCamera(1,  0);
-    if(keyboardState[SDL_SCANCODE_LEFT])   game.renderer.moveCamera(-1, 0);
-    if(keyboardState[SDL_SCANCODE_DOWN])   game.renderer.moveCamera(0,  1);
-    if(keyboardState[SDL_SCANCODE_UP])     game.renderer.moveCamera(0, -1);
 
     #undef latestEvent
 }
 
+void InputHandler::processHeldKeys(Game& game) {
+    //pixels per tick, ~120 pixels per second at 60 ticks per second
+    static constexpr i32 cameraSpeed = 2;
+
+    const u8* keyboardState = Program::getKeyboardState();
+
+    if(keyboardState[SDL_SCANCODE_RIGHT])  game.renderer.moveCamera(cameraSpeed,  0);
+    if(keyboardState[SDL_SCANCODE_LEFT])   game.renderer.moveCamera(-cameraSpeed, 0);
+    if(keyboardState[SDL_SCANCODE_DOWN])   game.renderer.moveCamera(0,  cameraSpeed);
+    if(keyboardState[SDL_SCANCODE_UP])     game.renderer.moveCamera(0, -cameraSpeed);
+}
+
 void InputHandler::checkForKeyCombination(u64 comb) {
     for(int i = 0; i < 7; i++) {
         if(this->currentKeymap == nullptr) break; //no keymap, no keybinds
@@ -14,6 +14,17 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) {
     return test();
 #else
     Game game;
+    //--headless renders offscreen, --frames <n> quits after n frames
+    //and --capture <path> saves the last one, e.g. for golden images;
+    //--render-thread executes frames on a separate thread
+    const char* capturePath = nullptr;
+    for(int i = 1; i < argc; i++) {
+        if(!strcmp(argv[i], "--headless")) game.setHeadless(true);
+        else if(!strcmp(argv[i], "--frames") && i + 1 < argc) game.setFrameLimit(strtoull(argv[++i], nullptr, 10));
+        else if(!strcmp(argv[i], "--capture") && i + 1 < argc) capturePath = argv[++i];
+        else if(!strcmp(argv[i], "--render-thread")) game.setRenderThreadEnabled(true);
+    }
+
     Status status = game.init();
     if(status != Status::SUCCESS) Unlikely {
         char message[128];
@@ -49,6 +60,13 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) {
         return static_cast<int>(Status::ALLOC_FAILURE);
     }
 
+    if(capturePath != nullptr) {
+        status = game.saveFrame(capturePath);
+        if(status != Status::SUCCESS) {
+            Program::getLogger().error("Failed to save the last frame to ", capturePath, ": ", SDL_GetError());
+            return static_cast<int>(status);
+        }
+    }
 
     return 0;
 #endif
@@ -65,7 +83,9 @@ const char* testLogPath = "testLog.log";
 #include <windows.h>
 #elif defined(LINUX)
 //unistd.h is already present
+#include <fcntl.h>
 #endif
+#include <cstdarg>
 
 void __registerTestFunction__(fptr function) {
     if(testHooks.size() == testHooks.capacity()) {
@@ -86,7 +106,7 @@ void __registerTestFunction__(fptr function) {
         CloseHandle(fd);
         ExitProcess(1);
 #elif defined(LINUX)
-        int fd = open(testLogPath, O_CREAT | O_WRITE | O_TRUNC);
+        int fd = open(testLogPath, O_CREAT | O_WRONLY | O_TRUNC, 0644);
         if(fd == -1) {
             //literally the only way to exit on Linux
             //as stdlib.h's _exit conflicts with unistd.h's one
@@ -135,6 +155,16 @@ void __checkTestEq__(int v, const char isFatal, const char* failFmt, ...) {
     else numberOfPassedTests++;
 }
 
+void __reportBench__(const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    fprintf(testLog, "[⏱] ");
+    vfprintf(testLog, fmt, args);
+    va_end(args);
+    fprintf(testLog, "\n");
+    fflush(testLog);
+}
+
 int test() {
     setlocale(LC_ALL, "");
 
@@ -143,11 +173,11 @@ int test() {
     for(auto it = testHooks.begin(); it != testHooks.end(); ++it) {
         (*it)();
     }
-    fprintf(testLog, "%llu/%llu tests passed\n", numberOfPassedTests, numberOfTests);
+    fprintf(testLog, "%llu/%llu tests passed\n", (unsigned long long)numberOfPassedTests, (unsigned long long)numberOfTests);
     fclose(testLog);
 
     char message[128];
-    snprintf(message, sizeof(message), "%llu/%llu tests passed.", numberOfPassedTests, numberOfTests);
+    snprintf(message, sizeof(message), "%llu/%llu tests passed.", (unsigned long long)numberOfPassedTests, (unsigned long long)numberOfTests);
     SDL_ShowSimpleMessageBox(
         numberOfPassedTests < numberOfTests ?
         SDL_MESSAGEBOX_ERROR : SDL_MESSAGEBOX_INFORMATION,
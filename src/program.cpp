@@ -13,6 +13,7 @@ static constexpr Color defaultBackgroundColor = {80, 80, 80, 255};
 ResourceManager     Program::resourceManager;
 Logger              Program::logger;
 SDL_Renderer*       Program::renderingContext = nullptr;
+std::recursive_mutex Program::renderingLock;
 u64                 Program::clockFrequency;
 const uint8_t*      Program::keyboardState;
 
@@ -22,6 +23,10 @@ Status Program::initSystems() {
         SDL_SetHint(SDL_HINT_WINDOWS_DPI_AWARENESS, "permonitorv2");
         // SDL_SetHint(SDL_HINT_AUDIO_INCLUDE_MONITORS, "1");
     }
+    if(this->flags.headless) {
+        SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+        SDL_SetHint(SDL_HINT_AUDIODRIVER, "dummy");
+    }
     if(Program::logger.init("./log/latest.log") != Status::SUCCESS) return Status::LOGGER_FAILURE;
     Program::logger.info(platform);
     if(SDL_Init(SDL_InitFlags)) {
@@ -80,14 +85,27 @@ Status Program::initSystems() {
         SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
         windowParameters.size.width,
         windowParameters.size.height,
-        SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE
+        this->flags.headless ? SDL_WINDOW_HIDDEN : SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE
     );
     if(this->window == nullptr) {
         logger.fatal("Window creation failed: ", SDL_GetError());
         return Status::SDL_WINDOW_CREATION_FAILURE;
     }
 
-    Program::renderingContext = SDL_CreateRenderer(this->window, -1, 0);
+    if(this->flags.headless) {
+        //the dummy driver's window has no pixels to show,
+        //so frames go into a surface they can be read back from
+        this->frameSurface = SDL_CreateRGBSurfaceWithFormat(
+            0, windowParameters.size.width, windowParameters.size.height,
+            32, SDL_PIXELFORMAT_ARGB8888
+        );
+        if(this->frameSurface == nullptr) {
+            logger.fatal("Frame surface creation failed: ", SDL_GetError());
+            return Status::SDL_RENDERER_CREATION_FAILURE;
+        }
+        Program::renderingContext = SDL_CreateSoftwareRenderer(this->frameSurface);
+    }
+    else Program::renderingContext = SDL_CreateRenderer(this->window, -1, 0);
     if(Program::renderingContext == nullptr) {
         logger.fatal("Renderer creation failed: ", SDL_GetError());
         return Status::SDL_RENDERER_CREATION_FAILURE;
@@ -97,6 +115,9 @@ Status Program::initSystems() {
         Program::logger.fatal("Resource manager initialization failed");
         return Status::FALLBACK_TEXTURE_CREATION_FAILURE;
     }
+    //captured frames must not depend on how fast workers decode,
+    //so textures are loaded before the frame that first draws them
+    if(this->flags.headless) Program::resourceManager.setAsyncLoading(false);
     
     srand(time(nullptr));
     this->flags.running = true;
@@ -112,6 +133,7 @@ Status Program::initSystems() {
 Program::~Program() {
     this->resourceManager.shutdown();
     if(this->renderingContext != nullptr) SDL_DestroyRenderer(Program::renderingContext);
+    if(this->frameSurface != nullptr) SDL_FreeSurface(this->frameSurface);
     if(this->window != nullptr) SDL_DestroyWindow(this->window);
     if(this->flags.SDL_TTF_Initalized) TTF_Quit();
     if(this->flags.SDL_Mixer_Initialized) {
@@ -1,255 +1,422 @@
 #include "Game/GameRenderer.hpp"
 #include "Game/Main/Game.hpp"
 #include "Math.hpp"
+#include "Tracing.hpp"
 
+#include <algorithm>
+
+using namespace Enums;
 using namespace Structs;
 
 static constexpr double sizeOfBlockTexture = 64.0;
 
-/**
- * @brief Draws an arc on the current rendering target.
- * Used for drawing circular and elliptical arcs, as well as
- * circles and ellipses.
- * To draw a circular arc, set `rX` equal to `rY`.
- * 
- * @param renderer rendering context
- * @param center point around which the arc will be drawn
- * @param rX horizontal radius of the arc
- * @param rY vertical radius of the arc
- * @param start start of the arc in degrees, automatically clamped to [0, 360] degrees
- * @param end end of the arc in degrees, automatically clamped to [0, 360] degrees;
- * draws counterclockwise if `end < start`
- * @param centerColor color of the central point
- * @param outerColor color of outer points; if `outerColor` is different than
- * `centerColor` a gradient is applied between them
- * @param srcTex (optional) texture to copy pixel data from, if
- * `centerColor` and `outerColor` are not white, a mask from these colors is applied
- * @param srcTexCenter (optional) center point of the part of `srcTex`
- * to copy
- */
-void DrawArc(
-    SDL_Renderer* renderer, PointF center, float rX, float rY,
-    double start, double end, Color centerColor, Color outerColor,
-    SDL_Texture* srcTex, PointF srcTexCenter
-) {
-    float inv_w = 0.0f, inv_h = 0.0f;
-    if(srcTex) {
-        int texWidth, texHeight;
-        if(SDL_QueryTexture(srcTex, nullptr, nullptr, &texWidth, &texHeight)) return;
-        inv_w = 1.0f / (float)texWidth; inv_h = 1.0f / (float)texHeight;
-        if(srcTexCenter.x + rX > (float)texWidth || srcTexCenter.x - rX < 0.0f) return; //out-of-bounds
-        if(srcTexCenter.y + rY > (float)texHeight || srcTexCenter.y - rY < 0.0f) return; //out-of-bounds
-    }
-    constexpr double step = 1.0;
-
-    while(start < 0.0) { start += 360.0; }
-    while(start > 360.0) { start -= 360.0; }
-
-    while(end < 0.0) { end += 360.0; }
-    while(end > 360.0) { end -= 360.0; }
-
-    double angle = end - start;
-    if(angle < 0.0) angle += 360.0;
-    
-    u32 steps = (u32)(floor(abs(angle) * 10.0) * 0.1 * (1.0 / step));
-    SDL_Vertex vertices[(size_t)(360.0 / step) + 2];
-    int indices[3 * (size_t)(360.0 / step)];
-
-    vertices[0].position = {center.x, center.y};
-    vertices[0].color = *(SDL_Color*)&centerColor;
-    if(srcTex) vertices[0].tex_coord = {srcTexCenter.x * inv_w, srcTexCenter.y * inv_h};
-    {
-        u32 i;
-        float t;
-        if(start > end) {
-            for(i = 1, t = (float)(end + 360.0); i < steps + 2; i++, t -= (float)step) {
-                Vector2f off = {
-                    rX * Math::SinTable<(size_t)(90.0 / step), float>::at(t),
-                    -rY * Math::CosTable<(size_t)(90.0 / step), float>::at(t)
-                };
-                vertices[i].position = {
-                    center.x + off.x,
-                    center.y + off.y
-                };
-                vertices[i].color = *(SDL_Color*)&outerColor;
-                if(srcTex) {
-                    vertices[i].tex_coord = {
-                        (srcTexCenter.x + off.x) * inv_w,
-                        (srcTexCenter.y + off.y) * inv_h,
-                    };
-                }
-            }
-        }
-        else {
-            for(i = 1, t = (float)start; i < steps + 2; i++, t += (float)step) {
-                Vector2f off = {
-                    rX * Math::SinTable<(size_t)(90.0 / step), float>::at(t),
-                    -rY * Math::CosTable<(size_t)(90.0 / step), float>::at(t)
-                };
-                vertices[i].position = {
-                    center.x + off.x,
-                    center.y + off.y
-                };
-                vertices[i].color = *(SDL_Color*)&outerColor;
-                if(srcTex) {
-                    vertices[i].tex_coord = {
-                        (srcTexCenter.x + off.x) * inv_w,
-                        (srcTexCenter.y + off.y) * inv_h,
-                    };
-                }
-            }
-        }
-    }
-    for(u32 i = 0, j = 1; i < 3 * steps; i += 3, j++) {
-        indices[i] = 0;
-        indices[i + 1] = j;
-        indices[i + 2] = j + 1;
-    }
-
-    SDL_RenderGeometry(renderer, srcTex, vertices, steps + 2, indices, 3 * steps);
+static ForceInline i32 lerp(const i32 from, const i32 to, const double alpha) {
+    return from + (i32)round((double)(to - from) * alpha);
 }
 
-ForceInline void DrawCircle(
-    SDL_Renderer* renderer, PointF center, float r,
-    Color centerColor, Color outerColor,
-    SDL_Texture* srcTex, PointF srcTexCenter
-) {
-    DrawArc(renderer, center, r, r, 0.0, 360.0, centerColor, outerColor, srcTex, srcTexCenter);
+bool GameRenderer::FrameState::operator==(const FrameState& other) const {
+    return
+        this->camera.x == other.camera.x && this->camera.y == other.camera.y &&
+        this->scalingFactor == other.scalingFactor &&
+        this->windowSize.width == other.windowSize.width &&
+        this->windowSize.height == other.windowSize.height &&
+        this->backgroundColor.red == other.backgroundColor.red &&
+        this->backgroundColor.green == other.backgroundColor.green &&
+        this->backgroundColor.blue == other.backgroundColor.blue &&
+        this->backgroundColor.alpha == other.backgroundColor.alpha &&
+        this->worldVersion == other.worldVersion &&
+        this->uiVersion == other.uiVersion &&
+        this->alpha == other.alpha &&
+        this->testAngle == other.testAngle;
 }
 
-ForceInline void DrawEllipse(
-    SDL_Renderer* renderer, PointF center, float rX, float rY,
-    Color centerColor, Color outerColor,
-    SDL_Texture* srcTex, PointF srcTexCenter
-) {
-    DrawArc(renderer, center, rX, rY, 0.0, 360.0, centerColor, outerColor, srcTex, srcTexCenter);
-}
-
-void GameRenderer::renderInPlace(Game& game) {
+void GameRenderer::renderInPlace(Game& game, double alpha) {
+    TraceFunction();
     Size windowSize = game.getWindowSize();
     SDL_Rect r;
     Color backgroundColor = game.getBackgroundColor();
-    SDL_Renderer* renderer = game.getRenderingContext();
 
-    SDL_RenderClear(renderer);
-    SDL_SetRenderDrawColor(
-        renderer,
+    //the simulation runs at a fixed rate, so the frame
+    //is drawn between the last two ticks
+    alpha = std::clamp(alpha, 0.0, 1.0);
+    const Point camera = {
+        lerp(this->previousCameraPosition.x, this->cameraPosition.x, alpha),
+        lerp(this->previousCameraPosition.y, this->cameraPosition.y, alpha)
+    };
+    //the test arc spins every frame, so it's only part of the state while shown
+    const double testAngle = this->renderTestVisible
+        ? fmod(((double)Game::getNumberOfTicks() + alpha) * 2.4, 360.0)
+        : 0.0;
+
+    //Everything the frame is drawn from. If none of it changed,
+    //the frame would be identical to the last one, so it's skipped.
+    //UI elements changed during the latest tick are drawn between
+    //their old and new positions, so then every frame differs.
+    const u64 uiVersion = RenderableObjectBase::getVersion();
+    const FrameState state = {
+        camera, this->scalingFactor, windowSize, backgroundColor,
+        game.getWorld().getVersion(), uiVersion,
+        uiVersion != this->uiVersionAtTickStart ? alpha : 0.0,
+        testAngle
+    };
+    //textures finished loading are drawn instead of the fallback from now on
+    if(Program::getResourceManager().uploadLoadedTextures(this->textureUploadBudget) > 0) {
+        this->redrawRequested = true;
+    }
+    //the overlay's text changes every interval, not every frame
+    if(this->profilerOverlayVisible && (
+        this->profilerOverlayOutdated ||
+        Game::getNumberOfTicks() - this->profilerOverlayUpdatedAt >= profilerOverlayInterval
+    )) {
+        this->profilerOverlayOutdated = true;
+        this->redrawRequested = true;
+    }
+    if(!this->redrawRequested && state == this->lastFrameState) {
+        this->numberOfFramesSkipped++;
+        return;
+    }
+    this->lastFrameState = state;
+    this->redrawRequested = false;
+
+    //the frame is recorded here and executed on the render thread,
+    //while the next one is being simulated
+    RenderCommandBuffer& commands = this->renderThread.begin();
+    this->shapes.setCommandBuffer(&commands);
+    //only trimmed when a frame is recorded, so that textures
+    //drawn by the latest one are known to be in use
+    Program::getResourceManager().trimTextures();
+    //textures evicted since the last frame are destroyed after it
+    Program::getResourceManager().destroyRetiredTextures(commands);
+
+    commands.setRenderDrawColor(
         backgroundColor.red,
         backgroundColor.green,
         backgroundColor.green,
         backgroundColor.alpha
     );
+    commands.renderClear();
 
 
     /// Block rendering ///
+    FrameProfiler::Scope worldScope(this->profiler, FrameStage::WORLD);
     double pixelsPerBlock = sizeOfBlockTexture * this->scalingFactor;
     i32 pixelsPerBlockInt = (i32)pixelsPerBlock;
 
     BlockPos topLeftVisibleBlock = {
-        (i32)floor((double)this->cameraPosition.x / pixelsPerBlock),
-        (i32)floor((double)this->cameraPosition.y / pixelsPerBlock)
+        (i32)floor((double)camera.x / pixelsPerBlock),
+        (i32)floor((double)camera.y / pixelsPerBlock)
     };
 
+    //world's Y axis points up, while the screen's points down,
+    //so visible rows i correspond to world rows -i
+    const i32 minX = topLeftVisibleBlock.x;
+    const i32 maxX = topLeftVisibleBlock.x + (i32)ceil((double)windowSize.width/pixelsPerBlock);
+    const i32 maxY = -topLeftVisibleBlock.y;
+    const i32 minY = -(topLeftVisibleBlock.y + (i32)ceil((double)windowSize.height/pixelsPerBlock));
+
     r.w = r.h = pixelsPerBlockInt;
-    r.y = topLeftVisibleBlock.y * pixelsPerBlockInt - this->cameraPosition.y;
-    //The renderer iterates over blocks vertically and horizontally
-    //starting from the upper-left visible one
-    for(
-        i32 i = topLeftVisibleBlock.y;
-        i <= topLeftVisibleBlock.y + (i32)ceil((double)windowSize.height/pixelsPerBlock);
-        i++, r.y += pixelsPerBlockInt
-    ) {
-        r.x = topLeftVisibleBlock.x * pixelsPerBlockInt - this->cameraPosition.x;
-        for(
-            i32 j = topLeftVisibleBlock.x;
-            j <= topLeftVisibleBlock.x + (i32)ceil((double)windowSize.width/pixelsPerBlock);
-            j++, r.x += pixelsPerBlockInt
-        ) {
-            const Block* block = game.getWorld().getBlockAt(j, -i);
-            if(block == nullptr) continue;
-            if(block->getTexture() == nullptr) continue;
-
-            SDL_RenderCopy(
-                renderer,
-                block->getTexture(),
-                nullptr, &r
-            );
+    //neighbouring blocks are mostly the same, so the texture
+    //of the last one is reused instead of being looked up again
+    u32 lastBlockID = (u32)-1;
+    SDL_Texture* lastTexture = nullptr;
+    const AtlasRegion* lastRegion = nullptr;
+    u64 tilesDrawn = 0, blocksDrawn = 0;
+    //blocks packed into the atlas are batched and drawn
+    //with one call per atlas page, the rest is copied one by one
+    auto drawBlocks = [&](i32 x, i32 y, const u32* blockIDs, u32 count) {
+        r.x = x * pixelsPerBlockInt - camera.x;
+        r.y = -y * pixelsPerBlockInt - camera.y;
+        for(u32 k = 0; k < count; k++, r.x += pixelsPerBlockInt) {
+            if(blockIDs[k] != lastBlockID) {
+                lastBlockID = blockIDs[k];
+                lastRegion = this->blockAtlas.getRegion(lastBlockID);
+                if(lastRegion != nullptr && lastRegion->page == nullptr) lastRegion = nullptr;
+                const Block* block = Blocks::getBlockWithID(lastBlockID);
+                lastTexture = block != nullptr ? block->getTexture() : nullptr;
+            }
+            if(lastRegion != nullptr) {
+                this->blockBatch.addQuad(*lastRegion, {(float)r.x, (float)r.y, (float)r.w, (float)r.h});
+                blocksDrawn++;
+            }
+            else if(lastTexture != nullptr) {
+                commands.renderCopy(lastTexture, nullptr, &r);
+                blocksDrawn++;
+            }
+        }
+    };
+
+    World& world = game.getWorld();
+    if(pixelsPerBlockInt <= (i32)WorldOverview::maxPixelsPerBlock && !this->blockMips.isEmpty()) {
+        //Blocks this small show little more than their average color,
+        //so the world is drawn from images of whole regions at one pixel per block
+        const ChunkPos minRegion = WorldOverview::getRegionOf(World::getChunkPosOf(minX, minY));
+        const ChunkPos maxRegion = WorldOverview::getRegionOf(World::getChunkPosOf(maxX, maxY));
+        this->overview.beginFrame();
+
+        const i32 regionPixels = (i32)WorldOverview::regionPixels;
+        SDL_Rect regionRect;
+        regionRect.w = regionRect.h = regionPixels * pixelsPerBlockInt;
+        for(i32 ry = minRegion.y; ry <= maxRegion.y; ry++) {
+            for(i32 rx = minRegion.x; rx <= maxRegion.x; rx++) {
+                u32 numberOfChunks = 0;
+                SDL_Texture* texture = this->overview.get(commands, world, {rx, ry}, this->blockMips, &numberOfChunks);
+                if(texture == nullptr) continue;
+                tilesDrawn += numberOfChunks;
+
+                regionRect.x = rx * regionRect.w - camera.x;
+                //the image's top row is the region's highest one
+                regionRect.y = -(ry * regionPixels + regionPixels - 1) * pixelsPerBlockInt - camera.y;
+                commands.renderCopy(texture, nullptr, &regionRect);
+            }
+        }
+    }
+    else if(pixelsPerBlockInt <= (i32)ChunkTextureCache::maxPixelsPerBlock) {
+        //When zoomed out there are too many blocks to draw them one by one,
+        //so every visible chunk is drawn from its pre-rendered texture
+        const ChunkPos minChunk = World::getChunkPosOf(minX, minY);
+        const ChunkPos maxChunk = World::getChunkPosOf(maxX, maxY);
+        this->chunkTextureCache.beginFrame(
+            commands, (u32)pixelsPerBlockInt,
+            {(minChunk.x + maxChunk.x) / 2, (minChunk.y + maxChunk.y) / 2}
+        );
+
+        const i32 chunkSize = (i32)Chunk::size;
+        SDL_Rect chunkRect;
+        chunkRect.w = chunkRect.h = chunkSize * pixelsPerBlockInt;
+        for(i32 cy = minChunk.y; cy <= maxChunk.y; cy++) {
+            for(i32 cx = minChunk.x; cx <= maxChunk.x; cx++) {
+                const Chunk* chunk = world.getChunk(cx, cy);
+                if(chunk == nullptr) continue;
+                tilesDrawn++;
+
+                SDL_Texture* texture = this->chunkTextureCache.get(commands, {cx, cy}, *chunk);
+                if(texture == nullptr) {
+                    world.forEachBlockRow(
+                        cx * chunkSize, cy * chunkSize,
+                        cx * chunkSize + chunkSize - 1, cy * chunkSize + chunkSize - 1,
+                        drawBlocks
+                    );
+                    continue;
+                }
+
+                chunkRect.x = cx * chunkRect.w - camera.x;
+                //the texture's top row is the chunk's highest one
+                chunkRect.y = -(cy * chunkSize + chunkSize - 1) * pixelsPerBlockInt - camera.y;
+                commands.renderCopy(texture, nullptr, &chunkRect);
+            }
         }
     }
+    else world.forEachBlockRow(minX, minY, maxX, maxY, [&](i32 x, i32 y, const u32* blockIDs, u32 count) {
+        //every visible chunk hands out exactly one run starting
+        //at its lowest visible row and leftmost visible column
+        const ChunkPos chunk = World::getChunkPosOf(x, y);
+        if(
+            x == std::max(minX, chunk.x * (i32)Chunk::size) &&
+            y == std::max(minY, chunk.y * (i32)Chunk::size)
+        ) tilesDrawn++;
+        drawBlocks(x, y, blockIDs, count);
+    });
+    this->blockBatch.flush(commands, this->blockAtlas);
+    worldScope.stop();
     /// End of block rendering ///
 
-    this->uiElements.forEach([renderer = renderer](UIElement& element) {
+    FrameProfiler::Scope uiScope(this->profiler, FrameStage::UI);
+
+    this->uiElements.forEach([this, alpha](UIElement& element) {
         if(!element.isVisible()) return;
         element.render();
 
         SDL_Texture* texture = element.getTexture();
         if(!texture) return;
-        
-        Color colorMod = element.getModulation();
-        SDL_BlendMode blendMode = element.getBlendMode();
-        
-        //A hacky way to check if all fields in colorMod are 255
-        if(*((i32*)&colorMod) != (i32)-1) {
-            SDL_SetTextureColorMod(texture, colorMod.red, colorMod.green, colorMod.blue);
-            SDL_SetTextureAlphaMod(texture, colorMod.alpha);
-        }
-        
-        if(blendMode != SDL_BLENDMODE_NONE) {
-            SDL_SetTextureBlendMode(texture, blendMode);
-        }
 
-        SDL_RenderCopyEx(
-            renderer,
-            element.getTexture(),
-            &element.texturePortion,
-            &element.targetPortion,
-            element.angle,
-            nullptr, //might later add a center point to renderable objects I guess
-            element.flip
-        );
-        
-        //restore original color modulation
-        if(*((i32*)&colorMod) != (i32)-1) {
-            SDL_SetTextureColorMod(texture, 255, 255, 255);
-            SDL_SetTextureAlphaMod(texture, 255);
+        SDL_Rect target = element.targetPortion;
+        if(element.hasPreviousTargetPortion) {
+            const SDL_Rect& previous = element.previousTargetPortion;
+            target = {
+                lerp(previous.x, target.x, alpha), lerp(previous.y, target.y, alpha),
+                lerp(previous.w, target.w, alpha), lerp(previous.h, target.h, alpha)
+            };
         }
 
-        if(blendMode != SDL_BLENDMODE_NONE) {
-            SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE);
-        }
+        this->uiBatch.add({
+            texture,
+            element.texturePortion,
+            target,
+            element.angle,
+            element.flip,
+            element.getModulation(),
+            element.getBlendMode(),
+            element.layer
+        });
     });
+    //sprites are sorted to minimize texture state changes,
+    //the state is restored once per texture afterwards
+    this->uiBatch.flush(commands);
 
     ///    Section for render testing     ///
-    static double start = 0.0, end = 270.0;
-    SDL_Texture* tex = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, 320, 320);
-
-    Size s = Program::getResourceManager().getTextureOriginalSize(MainRegistry::gregTextureIndex);
-    PointF p = {(float)(s.width / 2), (float)(s.height / 2)};
-    SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
-    SDL_SetRenderTarget(renderer, tex);
-    DrawArc(
-        renderer, {160.0f, 160.0f}, 160.0f, 160.0f, start, end, Colors::YELLOW, Colors::MAGENTA,
-        Program::getResourceManager().getTexture(MainRegistry::gregTextureIndex), p
-    );
+    if(this->renderTestVisible) {
+        const double start = testAngle;
+        const double end = start + 270.0;
+        SDL_Texture* tex = this->renderTargets.acquire(commands, 320, 320);
+
+        Size s = Program::getResourceManager().getTextureOriginalSize(MainRegistry::gregTextureIndex);
+        PointF p = {(float)(s.width / 2), (float)(s.height / 2)};
+        commands.setTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+        commands.setRenderTarget(tex);
+        //pooled textures keep their contents from previous frames
+        commands.setRenderDrawColor(0, 0, 0, 0);
+        commands.renderClear();
+        this->shapes.arc(
+            {160.0f, 160.0f}, 160.0f, 160.0f, start, end, Colors::YELLOW, Colors::MAGENTA,
+            Program::getResourceManager().getTexture(MainRegistry::gregTextureIndex), p
+        );
 
-    // DrawCircle(renderer, {250.0f, 250.0f}, 125.0f, {255,255,255,0}, {255,255,255,0}, nullptr, {});
-    SDL_SetRenderTarget(renderer, nullptr);
-    SDL_Rect rr = {0, 0, 320, 320};
-    SDL_RenderCopy(renderer, tex, nullptr, &rr);
-    SDL_DestroyTexture(tex);
-    start += 1.0;
-    end += 1.0;
+        // this->shapes.circle({250.0f, 250.0f}, 125.0f, {255,255,255,0}, {255,255,255,0});
+        //pending shapes belong to the current target
+        this->shapes.flush();
+        commands.setRenderTarget(nullptr);
+        commands.setRenderDrawColor(
+            backgroundColor.red,
+            backgroundColor.green,
+            backgroundColor.green,
+            backgroundColor.alpha
+        );
+        SDL_Rect rr = {0, 0, 320, 320};
+        commands.renderCopy(tex, nullptr, &rr);
+        this->renderTargets.release(tex);
+    }
     /// End of section for render testing ///
+    //pending shapes belong to the UI too
+    this->shapes.flush();
+    uiScope.stop();
 
-    //TODO: formalize text rendering into a separate entity
-    //This can get complicated though as adding anything
-    //to the string to show requires recreating the entire texture
-    //but alas, let's hope that's a rare circumstance
+    FrameProfiler::Scope textScope(this->profiler, FrameStage::TEXT);
+    this->uiTextElements.forEach([this, &commands](UITextElement& element) {
+        if(!element.isVisible()) return;
+        element.render();
+        element.__draw(this->text, commands);
+    });
+    this->text.flush(commands);
+    textScope.stop();
 
-    SDL_RenderPresent(renderer);
+    if(this->profilerOverlayVisible) this->__drawProfilerOverlay(commands, windowSize);
+
+    FrameProfiler::Scope presentScope(this->profiler, FrameStage::PRESENT);
+    commands.renderPresent();
+    this->renderTargets.endFrame(commands);
+    this->shapes.endFrame();
+    //nothing can be added to the buffer once it's submitted
+    this->shapes.setCommandBuffer(nullptr);
+
+    this->frameStats = commands.getStats();
+    this->frameStats.tilesDrawn = tilesDrawn;
+    this->frameStats.tilesCulled = world.getChunkIndexStats().chunks - tilesDrawn;
+    this->frameStats.blocksDrawn = blocksDrawn;
+    this->renderThread.submit();
+    presentScope.stop();
     
     this->lastFrameAt = SDL_GetPerformanceCounter();
     this->numberOfFramesRendered++;
+    this->profiler.endFrame();
+}
+
+void GameRenderer::__drawProfilerOverlay(RenderCommandBuffer& commands, const Size windowSize) {
+    FrameProfiler::Scope scope(this->profiler, FrameStage::TEXT);
+
+    if(this->profilerOverlayOutdated) {
+        char* text = this->profilerOverlayText;
+        const size_t length = this->profiler.format(text, sizeof(this->profilerOverlayText));
+        //of the previous frame, this one is still being recorded
+        const RenderStats& stats = this->frameStats;
+        const GlyphAtlasStats textStats = this->text.getStats();
+        const TextTextureCacheStats textTextureStats = Program::getResourceManager().getTextTextureCacheStats();
+        const TextureLoaderStats loaderStats = Program::getResourceManager().getTextureLoaderStats();
+        const TextureResidencyStats residencyStats = Program::getResourceManager().getTextureResidencyStats();
+        snprintf(
+            text + length, sizeof(this->profilerOverlayText) - length,
+            "\n\ndraw calls %llu, vertices %llu"
+            "\ntexture switches %llu, targets %llu"
+            "\ndraw color %llu, color mod %llu, alpha %llu, blend %llu"
+            "\ntextures created %llu, destroyed %llu"
+            "\nchunks drawn %llu, culled %llu, blocks %llu"
+            "\nglyphs %llu, pages %llu"
+            "\ntext textures %llu, hits %llu, misses %llu"
+            "\ntextures loading %llu, uploaded %llu, failed %llu"
+            "\ntextures resident %llu (%llu KiB), expired %llu, evicted %llu, reloaded %llu",
+            (unsigned long long)stats.drawCalls, (unsigned long long)stats.vertices,
+            (unsigned long long)stats.textureSwitches, (unsigned long long)stats.targetSwitches,
+            (unsigned long long)stats.drawColorChanges, (unsigned long long)stats.colorModChanges,
+            (unsigned long long)stats.alphaChanges, (unsigned long long)stats.blendModeChanges,
+            (unsigned long long)stats.texturesCreated, (unsigned long long)stats.texturesDestroyed,
+            (unsigned long long)stats.tilesDrawn, (unsigned long long)stats.tilesCulled,
+            (unsigned long long)stats.blocksDrawn,
+            (unsigned long long)textStats.glyphs, (unsigned long long)textStats.pages,
+            (unsigned long long)textTextureStats.entries,
+            (unsigned long long)textTextureStats.hits, (unsigned long long)textTextureStats.misses,
+            (unsigned long long)loaderStats.pending, (unsigned long long)loaderStats.uploaded,
+            (unsigned long long)loaderStats.failed,
+            (unsigned long long)residencyStats.resident, (unsigned long long)(residencyStats.residentBytes / 1024),
+            (unsigned long long)residencyStats.expired, (unsigned long long)residencyStats.evicted,
+            (unsigned long long)residencyStats.reloaded
+        );
+        this->profilerOverlayUpdatedAt = Game::getNumberOfTicks();
+        this->profilerOverlayOutdated = false;
+    }
+
+    //new text only costs new vertices, glyphs are rasterized once
+    const Size size = this->text.measure(commands, MainRegistry::consolasFontIndex, this->profilerOverlayText, 640);
+    const SDL_FPoint position = {(float)windowSize.width - (float)size.width, 0.0f};
+    (void)this->text.draw(
+        commands, MainRegistry::consolasFontIndex, this->profilerOverlayText,
+        position, Colors::WHITE, 640
+    );
+    this->text.flush(commands);
+}
+
+Status GameRenderer::buildBlockAtlas(SDL_Renderer* renderer) {
+    const u32 numberOfBlocks = Blocks::getCurrentBlockID();
+    Vector<SDL_Texture*> textures(numberOfBlocks > 0 ? numberOfBlocks : 1);
+    ResourceManager& resources = Program::getResourceManager();
+    for(u32 i = 0; i < numberOfBlocks; i++) {
+        const Block* block = Blocks::getBlockWithID(i);
+        //blocks drawn from the atlas never touch their textures again, so
+        //they would be evicted first, and the atlas must not be built
+        //from the fallback texture drawn while they load asynchronously
+        (void)resources.setTexturePinned(block->textureHandle, true);
+        if(resources.loadTexture(block->textureHandle) != Status::SUCCESS) {
+            Program::getLogger().warn("Failed to load texture of block ", i, ": ", resources.getLatestError());
+        }
+        textures.append(block->getTexture());
+    }
+
+    //the atlas is built with the rendering context directly,
+    //so frames in flight must not be using the old one
+    this->renderThread.wait();
+    std::lock_guard<std::recursive_mutex> lock(Program::getRenderingLock());
+    Status s = this->blockAtlas.build(renderer, numberOfBlocks, textures.data());
+    //not fatal either, zoomed out blocks are shrunk from the atlas
+    //and the world overview isn't drawn
+    if(this->blockMips.build(renderer, numberOfBlocks, textures.data(), (u32)sizeOfBlockTexture) != Status::SUCCESS) {
+        Program::getLogger().warn("Failed to downsample block textures: ", SDL_GetError());
+    }
+    this->chunkTextureCache.setAtlas(
+        s == Status::SUCCESS ? &this->blockAtlas : nullptr,
+        this->blockMips.isEmpty() ? nullptr : &this->blockMips
+    );
+    //cached chunks may have been drawn with the old atlas
+    this->chunkTextureCache.clear();
+    this->overview.clear();
+    this->requestRedraw();
+    return s;
+}
+
+void GameRenderer::beginTick() {
+    this->previousCameraPosition = this->cameraPosition;
+    this->uiVersionAtTickStart = RenderableObjectBase::getVersion();
+    this->uiElements.forEach([](UIElement& element) {
+        element.previousTargetPortion = element.targetPortion;
+        element.hasPreviousTargetPortion = true;
+    });
 }
 
 void GameRenderer::moveCamera(i32 offX, i32 offY) {
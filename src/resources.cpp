@@ -1,8 +1,12 @@
-#include <cstdio>
+#include <algorithm>
 #include <cerrno>
+#include <cstdio>
+#include <tuple>
 
 #include "program.hpp"
 #include "resources.hpp"
+#include "Game/Render/RenderCommandBuffer.hpp"
+#include "Tracing.hpp"
 #include "util.hpp"
 
 using namespace Enums;
@@ -56,6 +60,17 @@ bool ResourceManager::isFontHandleValid(const FontHandle handle) const noexcept
     return handle < this->fonts.size();
 }
 
+//queried once when loaded, so that asking for it later needs neither
+//the texture to be loaded nor the rendering lock
+static void storeTextureSize(TextureData& data) noexcept {
+    u32 format;
+    int w, h;
+    if(SDL_QueryTexture(data.texture, &format, nullptr, &w, &h) != 0) return;
+    data.originalSize = {(u32)w, (u32)h};
+    const u64 bytesPerPixel = SDL_ISPIXELFORMAT_FOURCC(format) ? 4 : SDL_BYTESPERPIXEL(format);
+    data.bytes = (u64)w * (u64)h * bytesPerPixel;
+}
+
 
 SDL_Texture* ResourceManager::__createFallbackTexture() noexcept {
     SDL_Rect rect = {0, 0, (int)fallbackTextureSize.width, (int)fallbackTextureSize.height};
@@ -108,7 +123,7 @@ SDL_Texture* ResourceManager::__createFallbackTexture() noexcept {
 }
 
 Status ResourceManager::__registerTextureAt(
-    TextureHandle handle, const char* path, const u32 flags
+    TextureHandle handle, const char* path, const u32 flags, const u32 maxTimeLoaded
 ) noexcept {
     this->latestStatus = Status::SUCCESS;
     this->errorMessage = noErrorCString;
@@ -134,6 +149,7 @@ Status ResourceManager::__registerTextureAt(
             this->errorMessage = getFileOpenErrorMessage(this->latestStatus);
             return this->latestStatus;
         }
+        std::lock_guard<std::recursive_mutex> lock(Program::getRenderingLock());
         data.texture = IMG_LoadTexture(Program::getRenderingContext(), path);
         if(data.texture == nullptr) {
             // Program::getLogger().error("Cannot load texture: ", IMG_GetError());
@@ -142,6 +158,8 @@ Status ResourceManager::__registerTextureAt(
         }
         
         SDL_SetTextureScaleMode(data.texture, (SDL_ScaleMode)scaleMode);
+        storeTextureSize(data);
+        data.lastAccessedAt = SDL_GetPerformanceCounter();
         data.flags |= TextureFlags_LoadImmediately;
     }
 
@@ -157,7 +175,8 @@ Status ResourceManager::__registerTextureAt(
     }
     else data.location = path;
 
-    data.flags |= TextureFlags_IsValid;
+    data.flags |= (flags & TextureFlags_Pinned) | TextureFlags_IsValid;
+    data.milisecondsToUnload = maxTimeLoaded;
 
     // this->textures[handle].lastAccessedAt = SDL_GetPerformanceCounter();
     return this->latestStatus;
@@ -285,7 +304,14 @@ Status ResourceManager::__createTextTextureAt(
         goto failure;
     }
     
-    t = SDL_CreateTextureFromSurface(Program::getRenderingContext(), s);
+    {
+        std::lock_guard<std::recursive_mutex> lock(Program::getRenderingLock());
+        t = SDL_CreateTextureFromSurface(Program::getRenderingContext(), s);
+        if(t != nullptr) {
+            if(scaleMode > SDL_ScaleModeBest) scaleMode = SDL_ScaleModeBest;
+            SDL_SetTextureScaleMode(t, (SDL_ScaleMode)scaleMode);
+        }
+    }
     SDL_FreeSurface(s);
     if(t == nullptr) {
         this->latestStatus = Status::SDL_TEXTURE_CREATION_FAILURE;
@@ -293,11 +319,10 @@ Status ResourceManager::__createTextTextureAt(
         goto failure;
     }
 
-    if(scaleMode > SDL_ScaleModeBest) scaleMode = SDL_ScaleModeBest;
-    SDL_SetTextureScaleMode(t, (SDL_ScaleMode)scaleMode);
     data.flags |= scaleMode << 4;
 
     data.texture = t;
+    storeTextureSize(data);
     data.flags |= TextureFlags_IsValid;
 
     return this->latestStatus;
@@ -312,6 +337,169 @@ Status ResourceManager::__createTextTextureAt(
 
 
 
+bool ResourceManager::TextTextureKey::operator==(const TextTextureKey& other) const {
+    return
+        this->font == other.font &&
+        this->color.red == other.color.red &&
+        this->color.green == other.color.green &&
+        this->color.blue == other.color.blue &&
+        this->color.alpha == other.color.alpha &&
+        this->wrapLength == other.wrapLength &&
+        this->encoding == other.encoding &&
+        this->text == other.text;
+}
+
+size_t ResourceManager::TextTextureKeyHash::operator()(const TextTextureKey& key) const noexcept {
+    size_t hash = std::hash<std::string>{}(key.text);
+    const u32 color =
+        (u32)key.color.red << 24 | (u32)key.color.green << 16 |
+        (u32)key.color.blue << 8 | (u32)key.color.alpha;
+    const u64 rest =
+        ((u64)key.font << 32 | key.wrapLength) ^
+        ((u64)color << 1 | (u64)key.encoding);
+    hash ^= std::hash<u64>{}(rest) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+TextureHandle ResourceManager::__acquireTextTexture(
+    const void* text, const FontHandle font,
+    const Color foregroundColor, const u32 wrapLength, const TextEncoding encoding
+) noexcept {
+    this->latestStatus = Status::SUCCESS;
+    this->errorMessage = noErrorCString;
+
+    if(text == nullptr) {
+        this->latestStatus = Status::NULL_PASSED;
+        this->errorMessage = "Text variable passed was NULL";
+        return fallbackHandle;
+    }
+
+    const size_t length = encoding == TextEncoding::UTF16 ?
+        (wstrlen((const char16_t*)text) + 1) * 2 :
+        strlen((const char*)text) + 1;
+
+    auto it = this->textTextures.end();
+    try {
+        TextTextureKey key = {
+            std::string((const char*)text, length), font, foregroundColor, wrapLength, encoding
+        };
+        bool inserted;
+        std::tie(it, inserted) = this->textTextures.try_emplace(std::move(key), TextTextureEntry{fallbackHandle, 0, {}});
+        if(!inserted) {
+            this->textTextureStats.hits++;
+            if(it->second.references++ == 0) this->unreferencedTextTextures.erase(it->second.unreferencedAt);
+            return it->second.handle;
+        }
+        this->textTextureStats.misses++;
+
+        TextureHandle handle;
+        if(!this->freeTextTextureHandles.empty()) {
+            handle = this->freeTextTextureHandles.back();
+            this->freeTextTextureHandles.pop_back();
+        }
+        else if((handle = this->reserveTextureHandle()) == fallbackHandle) {
+            this->textTextures.erase(it);
+            return fallbackHandle;
+        }
+        it->second.handle = handle;
+        this->textTextureKeys[handle] = &it->first;
+
+        //the cached key outlives the texture, so the text isn't copied again
+        if(this->__createTextTextureAt(
+            handle, it->first.text.data(), 0, font, foregroundColor, wrapLength, encoding
+        ) != Status::SUCCESS) {
+            this->textures[handle] = TextureData();
+            this->textTextureKeys.erase(handle);
+            this->freeTextTextureHandles.push_back(handle);
+            this->textTextures.erase(it);
+            return fallbackHandle;
+        }
+
+        it->second.references = 1;
+        return handle;
+    }
+    catch(const std::bad_alloc&) {
+        //the handle, if any, is lost, but the cache stays consistent
+        if(it != this->textTextures.end()) {
+            this->textTextureKeys.erase(it->second.handle);
+            this->textTextures.erase(it);
+        }
+        this->latestStatus = Status::ALLOC_FAILURE;
+        this->errorMessage = OOM;
+        return fallbackHandle;
+    }
+}
+
+Status ResourceManager::releaseTextTexture(TextureHandle handle) noexcept {
+    const auto key = this->textTextureKeys.find(handle);
+    if(key == this->textTextureKeys.end()) {
+        this->errorMessage = "Texture handle is not a cached text texture";
+        return this->latestStatus = Status::INVALID_ARGS;
+    }
+
+    const TextTextureMap::iterator it = this->textTextures.find(*key->second);
+    TextTextureEntry& entry = it->second;
+    if(entry.references == 0) {
+        this->errorMessage = "Text texture has no references left";
+        return this->latestStatus = Status::INVALID_ARGS;
+    }
+    if(--entry.references == 0) {
+        try {
+            entry.unreferencedAt = this->unreferencedTextTextures.insert(
+                this->unreferencedTextTextures.end(), handle
+            );
+        }
+        catch(const std::bad_alloc&) {
+            //not kept for reuse then, but not lost either
+            if(!this->__evictTextTexture(it)) entry.references = 1;
+            return Status::SUCCESS;
+        }
+        this->__evictTextTextures(this->maxUnreferencedTextTextures);
+    }
+    return Status::SUCCESS;
+}
+
+void ResourceManager::setTextTextureCacheSize(const u32 maxUnreferenced) noexcept {
+    this->maxUnreferencedTextTextures = maxUnreferenced;
+    this->__evictTextTextures(maxUnreferenced);
+}
+
+bool ResourceManager::__evictTextTexture(const TextTextureMap::iterator it) noexcept {
+    //frames in flight may still be drawing it
+    const TextureHandle handle = it->second.handle;
+    TextureData& data = this->textures[handle];
+    try {
+        this->retiredTextures.reserve(this->retiredTextures.size() + 1);
+        this->freeTextTextureHandles.push_back(handle);
+    }
+    catch(const std::bad_alloc&) {
+        return false;
+    }
+    if(data.texture != nullptr) this->retiredTextures.push_back(data.texture);
+    data = TextureData();
+    this->textTextureKeys.erase(handle);
+    this->textTextures.erase(it);
+    this->textTextureStats.evictions++;
+    return true;
+}
+
+void ResourceManager::__evictTextTextures(const u32 maxUnreferenced) noexcept {
+    while(this->unreferencedTextTextures.size() > maxUnreferenced) {
+        const TextureHandle handle = this->unreferencedTextTextures.front();
+        const TextTextureMap::iterator it = this->textTextures.find(*this->textTextureKeys.find(handle)->second);
+        //kept until there's memory to remember it
+        if(!this->__evictTextTexture(it)) break;
+        this->unreferencedTextTextures.pop_front();
+    }
+}
+
+void ResourceManager::destroyRetiredTextures(RenderCommandBuffer& commands) noexcept {
+    for(size_t i = 0; i < this->retiredTextures.size(); i++) {
+        commands.destroyTexture(this->retiredTextures[i]);
+    }
+    this->retiredTextures.clear();
+}
+
 Status ResourceManager::init() noexcept {
     this->textures.reserve(128);
     this->soundEffects.reserve(16);
@@ -321,6 +509,7 @@ Status ResourceManager::init() noexcept {
     TextureData t = {this->__createFallbackTexture(), nullptr, 0, 0, 0};
     if(!t.texture) return this->latestStatus = Status::FALLBACK_TEXTURE_CREATION_FAILURE;
     t.flags |= TextureFlags_IsValid;
+    storeTextureSize(t);
     this->textures.push_back(t);
 
     memset((void*)&t, 0, sizeof(TextureData));
@@ -334,6 +523,13 @@ Status ResourceManager::init() noexcept {
 }
 
 void ResourceManager::shutdown() noexcept {
+    std::lock_guard<std::recursive_mutex> lock(Program::getRenderingLock());
+    this->loader.stop();
+    this->textureLoadCallbacks.clear();
+    for(size_t i = 0; i < this->retiredTextures.size(); i++) {
+        SDL_DestroyTexture(this->retiredTextures[i]);
+    }
+    this->retiredTextures.clear();
     for(size_t i = 0; i < this->textures.size(); i++) {
         if(this->textures[i].texture) SDL_DestroyTexture(this->textures[i].texture);
         if(this->textures[i].flags & TextureFlags_CopyPath) {
@@ -351,7 +547,7 @@ void ResourceManager::shutdown() noexcept {
     }
 }
 
-TextureHandle ResourceManager::registerTexture(const char* path, const u32 flags) noexcept {
+TextureHandle ResourceManager::registerTexture(const char* path, const u32 flags, const u32 maxTimeLoaded) noexcept {
     // Program::getLogger().info("Registering texture at ", path);
     
     TextureHandle handle = (TextureHandle)this->textures.size();
@@ -362,7 +558,7 @@ TextureHandle ResourceManager::registerTexture(const char* path, const u32 flags
         //TODO: make Program handle OOM
     }
 
-    switch(this->__registerTextureAt(handle, path, flags)) {
+    switch(this->__registerTextureAt(handle, path, flags, maxTimeLoaded)) {
         case Status::SUCCESS:
             return handle;
         //a very bad case, but won't cause a crashing state
@@ -393,6 +589,7 @@ TextureHandle ResourceManager::reserveTextureHandle() noexcept {
 }
 
 Status ResourceManager::loadTexture(TextureHandle handle) noexcept {
+    TraceFunction();
     if(!this->isTextureHandleValid(handle)) {
         this->errorMessage = invalidTexHandle;
         return this->latestStatus = Status::INVALID_ARGS;
@@ -422,6 +619,7 @@ Status ResourceManager::loadTexture(TextureHandle handle) noexcept {
         return this->latestStatus;
     }
     
+    std::lock_guard<std::recursive_mutex> lock(Program::getRenderingLock());
     data.texture = IMG_LoadTexture(Program::getRenderingContext(), data.location);
     if(data.texture == nullptr) {
         this->errorMessage = IMG_GetError();
@@ -431,11 +629,128 @@ Status ResourceManager::loadTexture(TextureHandle handle) noexcept {
     SDL_SetTextureScaleMode(
         data.texture, (SDL_ScaleMode)((data.flags & (0b11 << 4)) >> 4)
     );
-    
+    storeTextureSize(data);
+    //so that its time to unload starts now, not at its last use
+    data.lastAccessedAt = SDL_GetPerformanceCounter();
 
     return Status::SUCCESS;
 }
 
+Status ResourceManager::loadTextureAsync(TextureHandle handle, TextureLoadCallback callback) noexcept {
+    if(!this->isTextureHandleValid(handle)) {
+        this->errorMessage = invalidTexHandle;
+        return this->latestStatus = Status::INVALID_ARGS;
+    }
+
+    TextureData& data = this->textures[handle];
+    if(data.texture != nullptr) {
+        if(callback) callback(handle, Status::SUCCESS);
+        return Status::SUCCESS;
+    }
+
+    if(this->isTextTexture(handle)) {
+        this->errorMessage = "Cannot load texture - it is a text texture";
+        return this->latestStatus = Status::FAILURE;
+    }
+
+    if(data.location == nullptr) {
+        this->errorMessage = "Texture doesn't have a set location";
+        return this->latestStatus = Status::NULL_PASSED;
+    }
+
+    try {
+        if(callback) this->textureLoadCallbacks[handle].push_back(std::move(callback));
+    }
+    catch(const std::bad_alloc&) {
+        this->errorMessage = OOM;
+        return this->latestStatus = Status::ALLOC_FAILURE;
+    }
+    if(data.flags & TextureFlags_Loading) return Status::SUCCESS;
+
+    bool synchronous = !this->asyncLoading;
+    if(!synchronous && !this->loader.isRunning()) {
+        const u32 numberOfWorkers = std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u);
+        synchronous = this->loader.start(numberOfWorkers) != Status::SUCCESS;
+    }
+    if(synchronous) {
+        //no workers, so it's loaded right away
+        const Status status = this->loadTexture(handle);
+        this->__finishTextureLoad(handle, status);
+        return status;
+    }
+    if(this->loader.request(handle, data.location) != Status::SUCCESS) {
+        this->errorMessage = OOM;
+        this->__finishTextureLoad(handle, Status::ALLOC_FAILURE);
+        return this->latestStatus = Status::ALLOC_FAILURE;
+    }
+    data.flags = (data.flags & ~TextureFlags_LoadFailed) | TextureFlags_Loading;
+    return Status::SUCCESS;
+}
+
+void ResourceManager::__finishTextureLoad(const TextureHandle handle, const Status status) noexcept {
+    const auto it = this->textureLoadCallbacks.find(handle);
+    if(it == this->textureLoadCallbacks.end()) return;
+
+    //callbacks may request more textures
+    std::vector<TextureLoadCallback> callbacks = std::move(it->second);
+    this->textureLoadCallbacks.erase(it);
+    for(TextureLoadCallback& callback : callbacks) callback(handle, status);
+}
+
+u32 ResourceManager::uploadLoadedTextures(const u64 budget) noexcept {
+    TraceFunction();
+    const u64 start = SDL_GetPerformanceCounter();
+    u32 processed = 0;
+    TextureLoadResult result;
+    //at least one per call, so that loading always progresses
+    while((processed == 0 || SDL_GetPerformanceCounter() - start < budget) && this->loader.poll(result)) {
+        processed++;
+        Status status = result.status;
+        const TextureHandle handle = result.handle;
+
+        //the texture may have been destroyed or pointed elsewhere meanwhile
+        if(
+            !this->isTextureHandleValid(handle) ||
+            !(this->textures[handle].flags & TextureFlags_Loading) ||
+            this->textures[handle].location == nullptr ||
+            result.path != this->textures[handle].location
+        ) {
+            if(result.surface != nullptr) SDL_FreeSurface(result.surface);
+            if(!this->isTextureLoading(handle)) this->__finishTextureLoad(handle, Status::FAILURE);
+            continue;
+        }
+
+        TextureData& data = this->textures[handle];
+        data.flags &= ~TextureFlags_Loading;
+        //loaded synchronously meanwhile
+        if(data.texture == nullptr && result.surface != nullptr) {
+            std::lock_guard<std::recursive_mutex> lock(Program::getRenderingLock());
+            data.texture = SDL_CreateTextureFromSurface(Program::getRenderingContext(), result.surface);
+            if(data.texture != nullptr) {
+                SDL_SetTextureScaleMode(
+                    data.texture, (SDL_ScaleMode)((data.flags & (0b11 << 4)) >> 4)
+                );
+                storeTextureSize(data);
+                data.lastAccessedAt = SDL_GetPerformanceCounter();
+                this->texturesUploaded++;
+            }
+            else {
+                status = Status::SDL_TEXTURE_CREATION_FAILURE;
+                result.error = SDL_GetError();
+            }
+        }
+        if(result.surface != nullptr) SDL_FreeSurface(result.surface);
+
+        if(status != Status::SUCCESS) {
+            data.flags |= TextureFlags_LoadFailed;
+            Program::getLogger().warn("Cannot load texture ", result.path.c_str(), ": ", result.error.c_str());
+        }
+        this->__finishTextureLoad(handle, status);
+    }
+    this->textureUploadTime = SDL_GetPerformanceCounter() - start;
+    return processed;
+}
+
 Status ResourceManager::unloadTexture(TextureHandle handle) noexcept {
     if(!this->isTextureHandleValid(handle)) {
         this->errorMessage = invalidTexHandle;
@@ -443,6 +758,7 @@ Status ResourceManager::unloadTexture(TextureHandle handle) noexcept {
     }
 
     if(this->textures[handle].texture != nullptr) {
+        std::lock_guard<std::recursive_mutex> lock(Program::getRenderingLock());
         SDL_DestroyTexture(this->textures[handle].texture);
         this->textures[handle].texture = nullptr;
     }
@@ -455,6 +771,17 @@ SDL_Texture* ResourceManager::getTexture(TextureHandle handle) noexcept {
     
     TextureData& data = this->textures[handle];
     if(data.texture == nullptr) {
+        if(data.flags & TextureFlags_Evicted) {
+            data.flags &= ~TextureFlags_Evicted;
+            this->residencyStats.reloaded++;
+        }
+        if(this->asyncLoading && !this->isTextTexture(handle)) {
+            //loading mid-frame would stall it, the fallback is drawn meanwhile
+            if(!(data.flags & (TextureFlags_Loading | TextureFlags_LoadFailed))) {
+                (void)this->loadTextureAsync(handle);
+            }
+            return this->textures[0].texture;
+        }
         if(this->loadTexture(handle) != Status::SUCCESS) {
             return this->textures[0].texture;
         }
@@ -468,26 +795,22 @@ Size ResourceManager::getTextureOriginalSize(TextureHandle handle) noexcept {
     if(!this->isTextureHandleValid(handle)) 
         return fallbackTextureSize;
 
-    Size textureSize;
     TextureData& data = this->textures[handle];
-    
-    if(data.texture == nullptr) {
-        if(this->loadTexture(handle) != Status::SUCCESS) {
+    if(data.originalSize.width != 0) return data.originalSize;
+
+    //never loaded yet
+    if(this->asyncLoading && !this->isTextTexture(handle)) {
+        if(data.flags & TextureFlags_LoadFailed) return {0, 0};
+        //loading mid-frame would stall it, like for `getTexture(...)`
+        if(!(data.flags & TextureFlags_Loading) && this->loadTextureAsync(handle) != Status::SUCCESS) {
             return {0, 0};
         }
+        //callbacks of a synchronous load may have registered more textures
+        const TextureData& loaded = this->textures[handle];
+        return loaded.texture != nullptr ? loaded.originalSize : fallbackTextureSize;
     }
-
-    if(SDL_QueryTexture(
-        data.texture, nullptr, nullptr,
-        (int*)&textureSize.width, (int*)&textureSize.height)
-    ) {
-        this->latestStatus = Status::SDL_TEXTURE_QUERY_FAILURE;
-        this->errorMessage = SDL_GetError();
-        return {0, 0};
-    }
-    data.lastAccessedAt = SDL_GetPerformanceCounter();
-
-    return textureSize;
+    if(this->loadTexture(handle) != Status::SUCCESS) return {0, 0};
+    return data.originalSize;
 }
 
 Status ResourceManager::destroyTexture(TextureHandle handle) noexcept {
@@ -504,10 +827,13 @@ Status ResourceManager::destroyTexture(TextureHandle handle) noexcept {
     }
     data.location = nullptr;
     if(data.texture != nullptr) {
+        std::lock_guard<std::recursive_mutex> lock(Program::getRenderingLock());
         SDL_DestroyTexture(data.texture);
         data.texture = nullptr;
     }
     data.milisecondsToUnload = 0;
+    data.originalSize = {0, 0};
+    data.bytes = 0;
     data.flags = 0;
 
     return Status::SUCCESS;
@@ -519,6 +845,109 @@ bool ResourceManager::isTextTexture(TextureHandle handle) noexcept {
     return (this->textures[handle].flags & (TextureFlags_Text_UTF8 | TextureFlags_Text_UTF16)) != 0;
 }
 
+Status ResourceManager::setTextureUnloadTime(TextureHandle handle, const u32 maxTimeLoaded) noexcept {
+    if(!this->isTextureHandleValid(handle)) {
+        this->errorMessage = invalidTexHandle;
+        return this->latestStatus = Status::INVALID_ARGS;
+    }
+    this->textures[handle].milisecondsToUnload = maxTimeLoaded;
+    return Status::SUCCESS;
+}
+
+Status ResourceManager::setTexturePinned(TextureHandle handle, const bool pinned) noexcept {
+    if(!this->isTextureHandleValid(handle)) {
+        this->errorMessage = invalidTexHandle;
+        return this->latestStatus = Status::INVALID_ARGS;
+    }
+    if(pinned) this->textures[handle].flags |= TextureFlags_Pinned;
+    else this->textures[handle].flags &= ~TextureFlags_Pinned;
+    return Status::SUCCESS;
+}
+
+bool ResourceManager::__isTextureEvictable(const TextureHandle handle) noexcept {
+    const TextureData& data = this->textures[handle];
+    //the fallback texture and textures created at runtime have no path,
+    //text textures are only ever created from their text
+    return
+        handle != fallbackHandle &&
+        data.location != nullptr &&
+        !(data.flags & (TextureFlags_Pinned | TextureFlags_Loading)) &&
+        !this->isTextTexture(handle);
+}
+
+bool ResourceManager::__evictTexture(const TextureHandle handle) noexcept {
+    TextureData& data = this->textures[handle];
+    //frames in flight may still be drawing it
+    try {
+        this->retiredTextures.push_back(data.texture);
+    }
+    catch(const std::bad_alloc&) {
+        return false;
+    }
+    data.texture = nullptr;
+    data.flags |= TextureFlags_Evicted;
+    return true;
+}
+
+u32 ResourceManager::trimTextures() noexcept {
+    TraceFunction();
+    const u64 now = SDL_GetPerformanceCounter();
+    const u64 frequency = SDL_GetPerformanceFrequency();
+    u64 resident = 0, residentBytes = 0;
+    u32 unloaded = 0;
+
+    this->evictionCandidates.clear();
+    for(TextureHandle handle = 0; handle < this->textures.size(); handle++) {
+        const TextureData& data = this->textures[handle];
+        if(data.texture == nullptr || !(data.flags & TextureFlags_IsValid)) continue;
+
+        const u64 bytes = data.bytes;
+        if(this->__isTextureEvictable(handle)) {
+            if(
+                data.milisecondsToUnload > 0 &&
+                now - data.lastAccessedAt > (u64)data.milisecondsToUnload * frequency / 1000 &&
+                this->__evictTexture(handle)
+            ) {
+                this->residencyStats.expired++;
+                unloaded++;
+                continue;
+            }
+            //drawn by the latest frame, it would only be loaded again
+            if(data.lastAccessedAt < this->lastTrimAt) {
+                try {
+                    this->evictionCandidates.push_back({data.lastAccessedAt, handle, bytes});
+                }
+                catch(const std::bad_alloc&) {}
+            }
+        }
+        resident++;
+        residentBytes += bytes;
+    }
+
+    //the least recently used go first, sorting only happens when over the budget
+    if(this->textureMemoryBudget > 0 && residentBytes > this->textureMemoryBudget) {
+        std::sort(
+            this->evictionCandidates.begin(), this->evictionCandidates.end(),
+            [](const EvictionCandidate& a, const EvictionCandidate& b) {
+                return a.lastAccessedAt < b.lastAccessedAt;
+            }
+        );
+        for(const EvictionCandidate& candidate : this->evictionCandidates) {
+            if(residentBytes <= this->textureMemoryBudget) break;
+            if(!this->__evictTexture(candidate.handle)) break;
+            resident--;
+            residentBytes -= candidate.bytes;
+            this->residencyStats.evicted++;
+            unloaded++;
+        }
+    }
+
+    this->residencyStats.resident = resident;
+    this->residencyStats.residentBytes = residentBytes;
+    this->lastTrimAt = now;
+    return unloaded;
+}
+
 SFXHandle ResourceManager::loadSoundEffect(const char* path, u8 volume) noexcept {
     if((this->latestStatus = tryOpeningFile(path)) != Status::SUCCESS) {
         this->errorMessage = getFileOpenErrorMessage(this->latestStatus);